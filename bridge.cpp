@@ -1,8 +1,53 @@
 #include <bgfx.h>
 #include <bgfxplatform.h>
+#include <bgfx.c99.h>
 #include "bridge.h"
 
 BGFX_C_API void bgfx_dbg_text_print(uint32_t x, uint32_t y, uint8_t attr, const char *text) {
 	bgfx::dbgTextPrintf(x, y, attr, "%s", text);
 }
 
+BGFX_C_API uint32_t bgfx_set_transform_val(bgfx_mtx_t mtx) {
+	return bgfx_set_transform(mtx.m, 1);
+}
+
+BGFX_C_API void bgfx_set_view_transform_val(uint8_t id, bgfx_mtx_t view, bgfx_mtx_t proj) {
+	bgfx_set_view_transform(id, view.m, proj.m);
+}
+
+BGFX_C_API void bgfx_set_uniform_vec4(bgfx_uniform_handle_t handle, bgfx_vec4_t value) {
+	bgfx_set_uniform(handle, value.v, 1);
+}
+
+BGFX_C_API void bgfx_set_uniform_mtx(bgfx_uniform_handle_t handle, bgfx_mtx_t value) {
+	bgfx_set_uniform(handle, value.m, 1);
+}
+
+BGFX_C_API bgfx_vertex_buffer_handle_t bgfx_create_vertex_buffer_val(const void *data, uint32_t size, bgfx_vertex_decl_t decl) {
+	return bgfx_create_vertex_buffer(bgfx_copy(data, size), &decl);
+}
+
+BGFX_C_API bgfx_transient_vertex_buffer_t bgfx_alloc_transient_vertex_buffer_val(uint32_t num, bgfx_vertex_decl_t decl) {
+	bgfx_transient_vertex_buffer_t tvb;
+	bgfx_alloc_transient_vertex_buffer(&tvb, num, &decl);
+	return tvb;
+}
+
+BGFX_C_API bgfx_transient_buffers_t bgfx_alloc_transient_buffers_val(bgfx_vertex_decl_t decl, uint32_t num_vertices, uint32_t num_indices, bool index32) {
+	bgfx_transient_buffers_t tb;
+	tb.ok = bgfx_alloc_transient_buffers(&tb.tvb, &decl, num_vertices, &tb.tib, num_indices, index32);
+	return tb;
+}
+
+BGFX_C_API void bgfx_set_transient_vertex_buffer_val(bgfx_transient_vertex_buffer_t tvb, uint32_t start_vertex, uint32_t num_vertices) {
+	bgfx_set_transient_vertex_buffer(&tvb, start_vertex, num_vertices);
+}
+
+BGFX_C_API void bgfx_set_transient_index_buffer_val(bgfx_transient_index_buffer_t tib, uint32_t first_index, uint32_t num_indices) {
+	bgfx_set_transient_index_buffer(&tib, first_index, num_indices);
+}
+
+BGFX_C_API void bgfx_vertex_pack_val(bgfx_vec4_t input, bool normalized, bgfx_attrib_t attr, bgfx_vertex_decl_t decl, void *data, uint32_t index) {
+	bgfx_vertex_pack(input.v, normalized, attr, &decl, data, index);
+}
+
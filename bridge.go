@@ -15,6 +15,7 @@ import (
 	"fmt"
 	"io"
 	"reflect"
+	"time"
 	"unsafe"
 )
 
@@ -31,8 +32,124 @@ const (
 	RendererTypeCount
 )
 
+// Init initializes the library with the platform default renderer.
 func Init() {
-	C.bgfx_init(C.BGFX_RENDERER_TYPE_NULL, nil, nil)
+	C.bgfx_init(C.BGFX_RENDERER_TYPE_COUNT, nil, nil, 2, nil)
+}
+
+// InitRenderer is like Init, but selects the renderer explicitly,
+// RendererTypeCount picks platform default. RendererTypeNull needs
+// neither a window nor a GPU, which makes it suitable for headless tools
+// and trace replay.
+func InitRenderer(renderer RendererType) {
+	C.bgfx_init(C.bgfx_renderer_type_t(renderer), nil, nil, 2, nil)
+}
+
+// Limits holds per frame resource limits and handle counts. Frame
+// storage and handle tables are allocated up front from these, fields
+// left at zero take library defaults.
+type Limits struct {
+	MaxDrawCalls          int // Up to 65535.
+	MaxMatrixCache        int
+	MaxRectCache          int // Up to 65535.
+	MaxConstantBufferSize int // Uniform data in bytes.
+	TransientVBSize       int // Transient vertex buffer size in bytes.
+	TransientIBSize       int // Transient index buffer size in bytes.
+
+	// Handle counts, up to 65535. MaxPrograms is also capped by the
+	// library, program index is part of draw sort key.
+	MaxIndexBuffers         int
+	MaxVertexBuffers        int
+	MaxDynamicIndexBuffers  int
+	MaxDynamicVertexBuffers int
+	MaxVertexDecls          int
+	MaxShaders              int
+	MaxPrograms             int
+	MaxTextures             int
+	MaxFrameBuffers         int
+	MaxUniforms             int
+}
+
+var errLimitRange = errors.New("bgfx: limit out of range")
+
+// InitWithLimits is like InitRenderer, but sizes per frame storage and
+// handle tables from limits. Small tools can start with less memory, and
+// large scenes can raise limits without rebuilding the library. It panics
+// when a limit is negative or does not fit its field.
+func InitWithLimits(renderer RendererType, limits Limits) {
+	for _, v := range []int{
+		limits.MaxDrawCalls,
+		limits.MaxRectCache,
+		limits.MaxIndexBuffers,
+		limits.MaxVertexBuffers,
+		limits.MaxDynamicIndexBuffers,
+		limits.MaxDynamicVertexBuffers,
+		limits.MaxVertexDecls,
+		limits.MaxShaders,
+		limits.MaxPrograms,
+		limits.MaxTextures,
+		limits.MaxFrameBuffers,
+		limits.MaxUniforms,
+	} {
+		if v < 0 || v > 0xffff {
+			panic(errLimitRange)
+		}
+	}
+	for _, v := range []int{
+		limits.MaxMatrixCache,
+		limits.MaxConstantBufferSize,
+		limits.TransientVBSize,
+		limits.TransientIBSize,
+	} {
+		if v < 0 || int64(v) > 0xffffffff {
+			panic(errLimitRange)
+		}
+	}
+	l := C.bgfx_limits_t{
+		maxDrawCalls:          C.uint16_t(limits.MaxDrawCalls),
+		maxMatrixCache:        C.uint32_t(limits.MaxMatrixCache),
+		maxRectCache:          C.uint32_t(limits.MaxRectCache),
+		maxConstantBufferSize: C.uint32_t(limits.MaxConstantBufferSize),
+		transientVbSize:       C.uint32_t(limits.TransientVBSize),
+		transientIbSize:       C.uint32_t(limits.TransientIBSize),
+
+		maxIndexBuffers:         C.uint16_t(limits.MaxIndexBuffers),
+		maxVertexBuffers:        C.uint16_t(limits.MaxVertexBuffers),
+		maxDynamicIndexBuffers:  C.uint16_t(limits.MaxDynamicIndexBuffers),
+		maxDynamicVertexBuffers: C.uint16_t(limits.MaxDynamicVertexBuffers),
+		maxVertexDecls:          C.uint16_t(limits.MaxVertexDecls),
+		maxShaders:              C.uint16_t(limits.MaxShaders),
+		maxPrograms:             C.uint16_t(limits.MaxPrograms),
+		maxTextures:             C.uint16_t(limits.MaxTextures),
+		maxFrameBuffers:         C.uint16_t(limits.MaxFrameBuffers),
+		maxUniforms:             C.uint16_t(limits.MaxUniforms),
+	}
+	C.bgfx_init(C.bgfx_renderer_type_t(renderer), nil, nil, 2, &l)
+}
+
+// CurrentLimits returns per frame resource limits set at init, with
+// defaults filled in.
+func CurrentLimits() Limits {
+	l := C.bgfx_get_limits()
+	return Limits{
+		MaxDrawCalls:          int(l.maxDrawCalls),
+		MaxMatrixCache:        int(l.maxMatrixCache),
+		MaxRectCache:          int(l.maxRectCache),
+		MaxConstantBufferSize: int(l.maxConstantBufferSize),
+		TransientVBSize:       int(l.transientVbSize),
+		TransientIBSize:       int(l.transientIbSize),
+
+		MaxIndexBuffers:         int(l.maxIndexBuffers),
+		MaxVertexBuffers:        int(l.maxVertexBuffers),
+		MaxDynamicIndexBuffers:  int(l.maxDynamicIndexBuffers),
+		MaxDynamicVertexBuffers: int(l.maxDynamicVertexBuffers),
+		MaxVertexDecls:          int(l.maxVertexDecls),
+		MaxShaders:              int(l.maxShaders),
+		MaxPrograms:             int(l.maxPrograms),
+		MaxTextures:             int(l.maxTextures),
+		MaxFrameBuffers:         int(l.maxFrameBuffers),
+		MaxUniforms:             int(l.maxUniforms),
+	}
 }
 
 func Shutdown() {
@@ -70,6 +187,7 @@ const (
 	DebugIFH
 	DebugStats
 	DebugText
+	DebugProfiler
 )
 
 func SetDebug(f DebugOptions) {
@@ -166,6 +284,7 @@ const (
 	CapsCompute
 	CapsFragmentOrdering
 	CapsSwapChain
+	CapsIndex32
 )
 
 type Capabilities struct {
@@ -193,6 +312,243 @@ func Caps() Capabilities {
 	}
 }
 
+// GLCall is category of OpenGL calls counted by renderer, it indexes
+// FrameStats.GLCalls.
+type GLCall int
+
+const (
+	GLCallBindBuffer GLCall = iota
+	GLCallBindTexture
+	GLCallActiveTexture
+	GLCallUseProgram
+	GLCallBindFramebuffer
+	GLCallBindVertexArray
+	GLCallBindSampler
+	GLCallEnable
+	GLCallUniform
+	GLCallDraw
+	GLCallInvalidate
+
+	GLCallCount
+)
+
+// FrameStats holds frame timing and renderer statistics.
+type FrameStats struct {
+	CPUTimeSubmit   time.Duration
+	CPUTimeRender   time.Duration
+	CPUTimeFlip     time.Duration
+	WaitRender      time.Duration
+	WaitSubmit      time.Duration
+	WaitPacing      time.Duration
+	PredictedRender time.Duration
+	Latency         time.Duration
+	LatencyMin      time.Duration
+	LatencyMax      time.Duration
+
+	// Draw and compute calls of last frame. Calls over
+	// Limits.MaxDrawCalls are dropped.
+	NumDraws   int
+	NumDropped int
+
+	// State cache counters, kept only by OpenGL renderer. Hits, misses
+	// and evictions are counted since Init.
+	NumVAOStates     int
+	VAOHits          int
+	VAOMisses        int
+	VAOEvictions     int
+	NumSamplerStates int
+	SamplerHits      int
+	SamplerMisses    int
+	SamplerEvictions int
+
+	// OpenGL calls of last frame, kept only by OpenGL renderer. Filtered
+	// calls matched state shadow and didn't reach the driver.
+	GLCalls         [GLCallCount]int
+	GLCallsFiltered [GLCallCount]int
+}
+
+// Stats returns frame timing and renderer statistics. Note that the
+// library must be initialized.
+func Stats() FrameStats {
+	stats := C.bgfx_get_stats()
+	freq := float64(stats.cpuTimerFreq)
+	dur := func(ticks C.int64_t) time.Duration {
+		return time.Duration(float64(ticks) * float64(time.Second) / freq)
+	}
+	fs := FrameStats{
+		CPUTimeSubmit:   dur(stats.cpuTimeSubmit),
+		CPUTimeRender:   dur(stats.cpuTimeRender),
+		CPUTimeFlip:     dur(stats.cpuTimeFlip),
+		WaitRender:      dur(stats.waitRender),
+		WaitSubmit:      dur(stats.waitSubmit),
+		WaitPacing:      dur(stats.waitPacing),
+		PredictedRender: dur(stats.predictedRender),
+		Latency:         dur(stats.latency),
+		LatencyMin:      dur(stats.latencyMin),
+		LatencyMax:      dur(stats.latencyMax),
+
+		NumDraws:   int(stats.numDraws),
+		NumDropped: int(stats.numDropped),
+
+		NumVAOStates:     int(stats.numVaoStates),
+		VAOHits:          int(stats.vaoHits),
+		VAOMisses:        int(stats.vaoMisses),
+		VAOEvictions:     int(stats.vaoEvictions),
+		NumSamplerStates: int(stats.numSamplerStates),
+		SamplerHits:      int(stats.samplerHits),
+		SamplerMisses:    int(stats.samplerMisses),
+		SamplerEvictions: int(stats.samplerEvictions),
+	}
+	for i := range fs.GLCalls {
+		fs.GLCalls[i] = int(stats.glCalls[i])
+		fs.GLCallsFiltered[i] = int(stats.glCallsFiltered[i])
+	}
+	return fs
+}
+
+// BufferPoolStats holds statistics of the backing buffers dynamic buffers
+// are sub-allocated from.
+type BufferPoolStats struct {
+	Size          int // Total size of backing buffers in bytes.
+	Used          int // Bytes used by live dynamic buffers.
+	LargestFree   int // Largest free range in bytes.
+	NumBuffers    int
+	NumAllocs     int
+	NumFreeRanges int
+	NumReleased   int // Empty backing buffers released so far.
+	NumRelocated  int // Dynamic buffers relocated by compaction so far.
+}
+
+// PoolStats returns dynamic index and vertex buffer backing pool
+// statistics. Backing buffers that stay empty for a number of frames are
+// released, and a dynamic buffer updated as a whole is moved out of a
+// sparse backing buffer so that it can drain.
+func PoolStats() (index, vertex BufferPoolStats) {
+	var ib, vb C.bgfx_buffer_pool_stats_t
+	C.bgfx_get_buffer_pool_stats(&ib, &vb)
+	conv := func(stats *C.bgfx_buffer_pool_stats_t) BufferPoolStats {
+		return BufferPoolStats{
+			Size:          int(stats.size),
+			Used:          int(stats.used),
+			LargestFree:   int(stats.largestFree),
+			NumBuffers:    int(stats.numBuffers),
+			NumAllocs:     int(stats.numAllocs),
+			NumFreeRanges: int(stats.numFreeRanges),
+			NumReleased:   int(stats.numReleased),
+			NumRelocated:  int(stats.numRelocated),
+		}
+	}
+	return conv(&ib), conv(&vb)
+}
+
+// TransientFrameBufferPoolStats holds statistics of the transient frame
+// buffer pool.
+type TransientFrameBufferPoolStats struct {
+	RequestedSize   int // Size requested in last frame, without aliasing.
+	AllocatedSize   int // Size of pooled frame buffers.
+	NumRequests     int // Frame buffers requested in last frame.
+	NumFrameBuffers int // Pooled frame buffers.
+	NumCreated      int // Pooled frame buffers created so far.
+	NumReleased     int // Pooled frame buffers released so far.
+}
+
+// TransientFrameBufferStats returns transient frame buffer pool
+// statistics. Pooled frame buffers unused for a number of frames are
+// released.
+func TransientFrameBufferStats() TransientFrameBufferPoolStats {
+	var stats C.bgfx_transient_frame_buffer_stats_t
+	C.bgfx_get_transient_frame_buffer_stats(&stats)
+	return TransientFrameBufferPoolStats{
+		RequestedSize:   int(stats.requestedSize),
+		AllocatedSize:   int(stats.allocatedSize),
+		NumRequests:     int(stats.numRequests),
+		NumFrameBuffers: int(stats.numFrameBuffers),
+		NumCreated:      int(stats.numCreated),
+		NumReleased:     int(stats.numReleased),
+	}
+}
+
+// WaitFrameStart blocks until the latest time the next frame can start
+// and still be submitted before the render thread runs out of work. Call
+// it after Frame, right before sampling input.
+func WaitFrameStart() {
+	C.bgfx_wait_frame_start()
+}
+
+// RecordBegin starts recording API calls into a trace file at path.
+// Resources created before recording started are not part of the trace,
+// so start recording right after Init to capture everything.
+func RecordBegin(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	if !C.bgfx_record_begin(cpath) {
+		return fmt.Errorf("bgfx: can't record trace to %s", path)
+	}
+	return nil
+}
+
+// RecordEnd stops recording and closes the trace file.
+func RecordEnd() {
+	C.bgfx_record_end()
+}
+
+// ReplayStats holds statistics of a single replayed frame.
+type ReplayStats struct {
+	Frame      int
+	NumCalls   int
+	NumSubmits int
+	IssueTime  time.Duration // Issuing API calls, excluding trace IO.
+	FrameTime  time.Duration // Frame call.
+}
+
+// ReplayBegin opens a trace file written by RecordBegin for replay. The
+// trace can be replayed with any renderer, including RendererTypeNull.
+func ReplayBegin(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	if !C.bgfx_replay_begin(cpath) {
+		return fmt.Errorf("bgfx: can't replay trace %s", path)
+	}
+	return nil
+}
+
+// ReplayFrame replays the next recorded frame, including its Frame call.
+// It returns false at the end of the trace.
+func ReplayFrame() (ReplayStats, bool) {
+	var stats C.bgfx_replay_stats_t
+	if !C.bgfx_replay_frame(&stats) {
+		return ReplayStats{}, false
+	}
+	freq := float64(C.bgfx_get_stats().cpuTimerFreq)
+	dur := func(ticks C.int64_t) time.Duration {
+		return time.Duration(float64(ticks) * float64(time.Second) / freq)
+	}
+	return ReplayStats{
+		Frame:      int(stats.frame),
+		NumCalls:   int(stats.numCalls),
+		NumSubmits: int(stats.numSubmits),
+		IssueTime:  dur(stats.cpuTimeIssue),
+		FrameTime:  dur(stats.cpuTimeFrame),
+	}, true
+}
+
+// ReplayEnd stops replaying, destroys resources the trace didn't destroy
+// and closes the trace file.
+func ReplayEnd() {
+	C.bgfx_replay_end()
+}
+
+// SaveProfile writes profiler zones captured while DebugProfiler is set
+// to path in Chrome trace event format.
+func SaveProfile(path string) error {
+	cpath := C.CString(path)
+	defer C.free(unsafe.Pointer(cpath))
+	if !C.bgfx_profiler_save(cpath) {
+		return fmt.Errorf("bgfx: can't save profile to %s", path)
+	}
+	return nil
+}
+
 type UniformType uint8
 
 const (
@@ -230,12 +586,25 @@ func VertexPack(input [4]float32, normalized bool, attrib Attrib, decl VertexDec
 	if val.Kind() != reflect.Slice {
 		panic(errors.New("bgfx: expected slice"))
 	}
-	C.bgfx_vertex_pack(
-		(*C.float)(unsafe.Pointer(&input)),
+	vertexPack(&input, normalized, attrib, &decl, unsafe.Pointer(val.Pointer()), index)
+}
+
+// VertexPackBytes is like VertexPack, but without reflection, vertex
+// stream is raw bytes.
+func VertexPackBytes(input [4]float32, normalized bool, attrib Attrib, decl VertexDecl, data []byte, index int) {
+	if index < 0 || (index+1)*decl.Stride() > len(data) {
+		panic(errors.New("bgfx: vertex index out of range"))
+	}
+	vertexPack(&input, normalized, attrib, &decl, unsafe.Pointer(&data[0]), index)
+}
+
+func vertexPack(input *[4]float32, normalized bool, attrib Attrib, decl *VertexDecl, data unsafe.Pointer, index int) {
+	C.bgfx_vertex_pack_val(
+		*(*C.bgfx_vec4_t)(unsafe.Pointer(input)),
 		C._Bool(normalized),
 		C.bgfx_attrib_t(attrib),
-		&decl.decl,
-		unsafe.Pointer(val.Pointer()),
+		decl.decl,
+		data,
 		C.uint32_t(index),
 	)
 }
@@ -255,6 +624,68 @@ func VertexUnpack(attrib Attrib, decl VertexDecl, slice interface{}, index int)
 	return
 }
 
+// vectorSlice validates slice of float32 vectors, f.e. [][3]float32,
+// and returns number of vectors and number of elements per vector.
+func vectorSlice(vectors interface{}) (ptr unsafe.Pointer, num, elems int) {
+	val := reflect.ValueOf(vectors)
+	if val.Kind() != reflect.Slice {
+		panic(errors.New("bgfx: expected slice"))
+	}
+	typ := val.Type().Elem()
+	if typ.Kind() != reflect.Array || typ.Elem().Kind() != reflect.Float32 ||
+		typ.Len() < 1 || typ.Len() > 4 {
+		panic(errors.New("bgfx: expected slice of [1-4]float32"))
+	}
+	return unsafe.Pointer(val.Pointer()), val.Len(), typ.Len()
+}
+
+// vertexSlice validates that num vertices starting at index fit into
+// vertex stream slice.
+func vertexSlice(decl VertexDecl, slice interface{}, index, num int) unsafe.Pointer {
+	val := reflect.ValueOf(slice)
+	if val.Kind() != reflect.Slice {
+		panic(errors.New("bgfx: expected slice"))
+	}
+	size := val.Len() * int(val.Type().Elem().Size())
+	if index < 0 || (index+num)*decl.Stride() > size {
+		panic(errors.New("bgfx: vertex index out of range"))
+	}
+	return unsafe.Pointer(val.Pointer())
+}
+
+// VertexPackArray packs input vectors into attrib of consecutive vertices
+// starting at index, input is slice of [1-4]float32.
+func VertexPackArray(input interface{}, normalized bool, attrib Attrib, decl VertexDecl, slice interface{}, index int) {
+	inputPtr, num, elems := vectorSlice(input)
+	data := vertexSlice(decl, slice, index, num)
+	C.bgfx_vertex_pack_array(
+		(*C.float)(inputPtr),
+		C.uint8_t(elems),
+		C._Bool(normalized),
+		C.bgfx_attrib_t(attrib),
+		&decl.decl,
+		data,
+		C.uint32_t(num),
+		C.uint32_t(index),
+	)
+}
+
+// VertexUnpackArray unpacks attrib of consecutive vertices starting at
+// index into output vectors, output is slice of [1-4]float32.
+func VertexUnpackArray(output interface{}, attrib Attrib, decl VertexDecl, slice interface{}, index int) {
+	outputPtr, num, elems := vectorSlice(output)
+	data := vertexSlice(decl, slice, index, num)
+	C.bgfx_vertex_unpack_array(
+		(*C.float)(outputPtr),
+		C.uint8_t(elems),
+		C.bgfx_attrib_t(attrib),
+		&decl.decl,
+		data,
+		C.uint32_t(num),
+		C.uint32_t(index),
+	)
+}
+
 func VertexConvert(destDecl, srcDecl VertexDecl, dest, src interface{}) {
 	destVal := reflect.ValueOf(dest)
 	srcVal := reflect.ValueOf(src)
@@ -273,6 +704,597 @@ func VertexConvert(destDecl, srcDecl VertexDecl, dest, src interface{}) {
 		&srcDecl.decl, srcPtr, C.uint32_t(srcVal.Len()))
 }
 
+// VertexConvertPlan is a vertex stream conversion compiled once for a
+// pair of vertex declarations, and reused for any number of conversions.
+type VertexConvertPlan struct {
+	plan C.bgfx_vertex_convert_plan_t
+}
+
+func NewVertexConvertPlan(destDecl, srcDecl VertexDecl) *VertexConvertPlan {
+	p := new(VertexConvertPlan)
+	C.bgfx_vertex_convert_plan(&p.plan, &destDecl.decl, &srcDecl.decl)
+	return p
+}
+
+func (p *VertexConvertPlan) Convert(dest, src interface{}) {
+	destVal := reflect.ValueOf(dest)
+	srcVal := reflect.ValueOf(src)
+	switch {
+	case destVal.Kind() != reflect.Slice,
+		srcVal.Kind() != reflect.Slice:
+		panic(errors.New("bgfx: expected slice"))
+	case destVal.Len() != srcVal.Len():
+		panic(errors.New("bgfx: len(dest) != len(src)"))
+	case int(p.plan.dest_stride) != int(destVal.Type().Elem().Size()):
+		panic(errors.New("bgfx: stride != dest element size"))
+	case int(p.plan.src_stride) != int(srcVal.Type().Elem().Size()):
+		panic(errors.New("bgfx: stride != src element size"))
+	}
+	destPtr := unsafe.Pointer(destVal.Pointer())
+	srcPtr := unsafe.Pointer(srcVal.Pointer())
+	C.bgfx_vertex_convert_planned(&p.plan, destPtr, srcPtr, C.uint32_t(srcVal.Len()))
+}
+
+// WeldVertices fills output with index of unique vertex for every vertex
+// in slice, and returns number of unique vertices. Vertices are welded
+// when position and any extra attribs are within epsilon.
+func WeldVertices(output []uint32, decl VertexDecl, slice interface{}, epsilon float32, attribs ...Attrib) int {
+	val := reflect.ValueOf(slice)
+	switch {
+	case val.Kind() != reflect.Slice:
+		panic(errors.New("bgfx: expected slice"))
+	case len(output) != val.Len():
+		panic(errors.New("bgfx: len(output) != len(slice)"))
+	case decl.Stride() != int(val.Type().Elem().Size()):
+		panic(errors.New("bgfx: stride != slice element size"))
+	}
+	var mask uint32
+	for _, attrib := range attribs {
+		mask |= 1 << attrib
+	}
+	if len(output) == 0 {
+		return 0
+	}
+	return int(C.bgfx_weld_vertices32(
+		(*C.uint32_t)(unsafe.Pointer(&output[0])),
+		&decl.decl,
+		unsafe.Pointer(val.Pointer()),
+		C.uint32_t(len(output)),
+		C.float(epsilon),
+		C.uint32_t(mask),
+	))
+}
+
+var errIndexRange = errors.New("bgfx: index out of range")
+
+// checkIndices panics when indices reference vertex past numVertices,
+// optimizers index per vertex tables with them.
+func checkIndices(indices []uint32, numVertices int) {
+	for _, index := range indices {
+		if int64(index) >= int64(numVertices) {
+			panic(errIndexRange)
+		}
+	}
+}
+
+// OptimizeVertexCache reorders triangles in indices for post-transform
+// vertex cache. numVertices is number of vertices referenced by indices.
+func OptimizeVertexCache(indices []uint32, numVertices int) {
+	checkIndices(indices, numVertices)
+	if len(indices) == 0 {
+		return
+	}
+	C.bgfx_optimize_vertex_cache(
+		(*C.uint32_t)(unsafe.Pointer(&indices[0])),
+		C.uint32_t(len(indices)),
+		C.uint32_t(numVertices),
+	)
+}
+
+// OptimizeOverdraw reorders clusters of triangles in indices, which
+// should be optimized with OptimizeVertexCache first, so that triangles
+// likely to occlude the rest of mesh are drawn first.
+func OptimizeOverdraw(indices []uint32, decl VertexDecl, slice interface{}, cacheSize int) {
+	val := reflect.ValueOf(slice)
+	switch {
+	case val.Kind() != reflect.Slice:
+		panic(errors.New("bgfx: expected slice"))
+	case decl.Stride() != int(val.Type().Elem().Size()):
+		panic(errors.New("bgfx: stride != slice element size"))
+	}
+	checkIndices(indices, val.Len())
+	if len(indices) == 0 {
+		return
+	}
+	C.bgfx_optimize_overdraw(
+		(*C.uint32_t)(unsafe.Pointer(&indices[0])),
+		C.uint32_t(len(indices)),
+		&decl.decl,
+		unsafe.Pointer(val.Pointer()),
+		C.uint32_t(val.Len()),
+		C.uint32_t(cacheSize),
+	)
+}
+
+// OptimizeVertexFetch copies vertices from src to dest in order of first
+// use by indices, and remaps indices. remap is filled with new index of
+// every src vertex, or ^uint32(0) when vertex is unused. It returns
+// number of vertices written to dest.
+func OptimizeVertexFetch(dest interface{}, remap []uint32, decl VertexDecl, src interface{}, indices []uint32) int {
+	destVal := reflect.ValueOf(dest)
+	srcVal := reflect.ValueOf(src)
+	switch {
+	case destVal.Kind() != reflect.Slice,
+		srcVal.Kind() != reflect.Slice:
+		panic(errors.New("bgfx: expected slice"))
+	case destVal.Len() != srcVal.Len():
+		panic(errors.New("bgfx: len(dest) != len(src)"))
+	case len(remap) != srcVal.Len():
+		panic(errors.New("bgfx: len(remap) != len(src)"))
+	case decl.Stride() != int(destVal.Type().Elem().Size()),
+		decl.Stride() != int(srcVal.Type().Elem().Size()):
+		panic(errors.New("bgfx: stride != slice element size"))
+	}
+	checkIndices(indices, srcVal.Len())
+	if len(remap) == 0 || len(indices) == 0 {
+		return 0
+	}
+	return int(C.bgfx_optimize_vertex_fetch(
+		unsafe.Pointer(destVal.Pointer()),
+		(*C.uint32_t)(unsafe.Pointer(&remap[0])),
+		&decl.decl,
+		unsafe.Pointer(srcVal.Pointer()),
+		C.uint32_t(srcVal.Len()),
+		(*C.uint32_t)(unsafe.Pointer(&indices[0])),
+		C.uint32_t(len(indices)),
+	))
+}
+
+// VertexCacheStats are results of simulating FIFO post-transform vertex
+// cache. ACMR is number of transformed vertices per triangle, and ATVR
+// number of transformed vertices per referenced vertex, 1.0 is optimal.
+type VertexCacheStats struct {
+	Transformed int
+	ACMR        float32
+	ATVR        float32
+}
+
+// AnalyzeVertexCache simulates drawing indices through FIFO vertex cache
+// of cacheSize entries. numVertices is number of vertices referenced by
+// indices.
+func AnalyzeVertexCache(indices []uint32, numVertices, cacheSize int) VertexCacheStats {
+	checkIndices(indices, numVertices)
+	var stats C.bgfx_vertex_cache_stats_t
+	if len(indices) != 0 {
+		C.bgfx_analyze_vertex_cache(
+			&stats,
+			(*C.uint32_t)(unsafe.Pointer(&indices[0])),
+			C.uint32_t(len(indices)),
+			C.uint32_t(numVertices),
+			C.uint32_t(cacheSize),
+		)
+	}
+	return VertexCacheStats{
+		Transformed: int(stats.num_transformed),
+		ACMR:        float32(stats.acmr),
+		ATVR:        float32(stats.atvr),
+	}
+}
+
+// CullSpheres tests bounding spheres against view frustum of viewProj,
+// and sets bit i%32 of visible[i/32] when sphere i is at least partially
+// inside. oglNdc must be set when projection maps depth to [-1, 1].
+func CullSpheres(visible []uint32, viewProj [16]float32, oglNdc bool, x, y, z, radius []float32) {
+	n := len(x)
+	switch {
+	case len(y) != n, len(z) != n, len(radius) != n:
+		panic(errors.New("bgfx: sphere streams differ in length"))
+	case len(visible) < (n+31)/32:
+		panic(errors.New("bgfx: visible is too short"))
+	case n == 0:
+		return
+	}
+	C.bgfx_cull_spheres(
+		(*C.uint32_t)(unsafe.Pointer(&visible[0])),
+		unsafe.Pointer(&viewProj[0]),
+		(*C.float)(unsafe.Pointer(&x[0])),
+		(*C.float)(unsafe.Pointer(&y[0])),
+		(*C.float)(unsafe.Pointer(&z[0])),
+		(*C.float)(unsafe.Pointer(&radius[0])),
+		C.uint32_t(n),
+		C.bool(oglNdc),
+	)
+}
+
+// CullAABBs tests axis aligned bounding boxes against view frustum of
+// viewProj, and sets bit i%32 of visible[i/32] when box i is at least
+// partially inside. oglNdc must be set when projection maps depth to
+// [-1, 1].
+func CullAABBs(visible []uint32, viewProj [16]float32, oglNdc bool, minX, minY, minZ, maxX, maxY, maxZ []float32) {
+	n := len(minX)
+	switch {
+	case len(minY) != n, len(minZ) != n,
+		len(maxX) != n, len(maxY) != n, len(maxZ) != n:
+		panic(errors.New("bgfx: box streams differ in length"))
+	case len(visible) < (n+31)/32:
+		panic(errors.New("bgfx: visible is too short"))
+	case n == 0:
+		return
+	}
+	C.bgfx_cull_aabbs(
+		(*C.uint32_t)(unsafe.Pointer(&visible[0])),
+		unsafe.Pointer(&viewProj[0]),
+		(*C.float)(unsafe.Pointer(&minX[0])),
+		(*C.float)(unsafe.Pointer(&minY[0])),
+		(*C.float)(unsafe.Pointer(&minZ[0])),
+		(*C.float)(unsafe.Pointer(&maxX[0])),
+		(*C.float)(unsafe.Pointer(&maxY[0])),
+		(*C.float)(unsafe.Pointer(&maxZ[0])),
+		C.uint32_t(n),
+		C.bool(oglNdc),
+	)
+}
+
+// OcclusionBuffer is low resolution CPU depth buffer, used to reject
+// objects hidden behind occluders before they are submitted.
+type OcclusionBuffer struct {
+	ob            *C.bgfx_occlusion_buffer_t
+	width, height int
+}
+
+// OcclusionStats are statistics of occlusion buffer since last Begin.
+type OcclusionStats struct {
+	Occluders int
+	Triangles int
+	Tested    int
+	Visible   int
+}
+
+// NewOcclusionBuffer creates occlusion buffer. Width and height are
+// rounded up to multiple of 8, and must be at most 0xfff8.
+func NewOcclusionBuffer(width, height int) *OcclusionBuffer {
+	if width <= 0 || height <= 0 || width > 0xfff8 || height > 0xfff8 {
+		panic(errors.New("bgfx: invalid occlusion buffer size"))
+	}
+	return &OcclusionBuffer{
+		ob:     C.bgfx_create_occlusion_buffer(C.uint16_t(width), C.uint16_t(height)),
+		width:  (width + 7) &^ 7,
+		height: (height + 7) &^ 7,
+	}
+}
+
+// Destroy releases occlusion buffer, it must not be used afterwards.
+func (b *OcclusionBuffer) Destroy() {
+	C.bgfx_destroy_occlusion_buffer(b.ob)
+	b.ob = nil
+}
+
+// Size returns depth buffer size.
+func (b *OcclusionBuffer) Size() (width, height int) {
+	return b.width, b.height
+}
+
+// Begin starts collecting occluders for view, with the same matrices as
+// passed to SetViewTransform.
+func (b *OcclusionBuffer) Begin(view, proj [16]float32, oglNdc bool) {
+	C.bgfx_occlusion_begin(b.ob, unsafe.Pointer(&view[0]), unsafe.Pointer(&proj[0]), C.bool(oglNdc))
+}
+
+// AddOccluder transforms and clips occluder mesh. Vertices must be slice
+// of structs starting with float32 x, y, z position, and indices must be
+// in range of vertices.
+func (b *OcclusionBuffer) AddOccluder(mtx [16]float32, vertices interface{}, indices []uint32) {
+	val := reflect.ValueOf(vertices)
+	switch {
+	case val.Kind() != reflect.Slice:
+		panic(errors.New("bgfx: expected slice"))
+	case val.Type().Elem().Size() < 12:
+		panic(errors.New("bgfx: vertex is smaller than position"))
+	}
+	checkIndices(indices, val.Len())
+	if val.Len() == 0 || len(indices) == 0 {
+		return
+	}
+	C.bgfx_occlusion_add_occluder(
+		b.ob,
+		unsafe.Pointer(&mtx[0]),
+		unsafe.Pointer(val.Pointer()),
+		C.uint16_t(val.Type().Elem().Size()),
+		C.uint32_t(val.Len()),
+		(*C.uint32_t)(unsafe.Pointer(&indices[0])),
+		C.uint32_t(len(indices)),
+	)
+}
+
+// Rasterize rasterizes occluders added since Begin.
+func (b *OcclusionBuffer) Rasterize() {
+	C.bgfx_occlusion_rasterize(b.ob)
+}
+
+// TestAABBs tests world space axis aligned bounding boxes against view
+// frustum and occluders, and sets bit i%32 of visible[i/32] when box i
+// might be visible.
+func (b *OcclusionBuffer) TestAABBs(visible []uint32, minX, minY, minZ, maxX, maxY, maxZ []float32) {
+	n := len(minX)
+	switch {
+	case len(minY) != n, len(minZ) != n,
+		len(maxX) != n, len(maxY) != n, len(maxZ) != n:
+		panic(errors.New("bgfx: box streams differ in length"))
+	case len(visible) < (n+31)/32:
+		panic(errors.New("bgfx: visible is too short"))
+	case n == 0:
+		return
+	}
+	C.bgfx_occlusion_test_aabbs(
+		b.ob,
+		(*C.uint32_t)(unsafe.Pointer(&visible[0])),
+		(*C.float)(unsafe.Pointer(&minX[0])),
+		(*C.float)(unsafe.Pointer(&minY[0])),
+		(*C.float)(unsafe.Pointer(&minZ[0])),
+		(*C.float)(unsafe.Pointer(&maxX[0])),
+		(*C.float)(unsafe.Pointer(&maxY[0])),
+		(*C.float)(unsafe.Pointer(&maxZ[0])),
+		C.uint32_t(n),
+	)
+}
+
+// Stats returns occluder and test counts since last Begin.
+func (b *OcclusionBuffer) Stats() OcclusionStats {
+	var stats C.bgfx_occlusion_stats_t
+	C.bgfx_get_occlusion_stats(b.ob, &stats)
+	return OcclusionStats{
+		Occluders: int(stats.num_occluders),
+		Triangles: int(stats.num_triangles),
+		Tested:    int(stats.num_tested),
+		Visible:   int(stats.num_visible),
+	}
+}
+
+// ReadDepth copies depth buffer into depth, rows from top to bottom.
+func (b *OcclusionBuffer) ReadDepth(depth []float32) {
+	if len(depth) < b.width*b.height {
+		panic(errors.New("bgfx: depth is too short"))
+	}
+	C.bgfx_read_occlusion_depth(b.ob, (*C.float)(unsafe.Pointer(&depth[0])))
+}
+
+// MeshBounds are bounding volumes of mesh or mesh group, Sphere is
+// center and radius.
+type MeshBounds struct {
+	Sphere [4]float32
+	Min    [3]float32
+	Max    [3]float32
+}
+
+// MeshGroup is range of mesh triangles, f.e. triangles sharing material.
+type MeshGroup struct {
+	StartIndex  int
+	NumIndices  int
+	StartVertex int
+	NumVertices int
+	Bounds      MeshBounds
+}
+
+// Mesh is mesh container opened with OpenMesh or parsed with ParseMesh.
+// Vertices and Indices are raw vertex stream and index data inside of
+// container.
+type Mesh struct {
+	Decl        VertexDecl
+	Vertices    []byte
+	NumVertices int
+	Indices     []byte
+	NumIndices  int
+	Index32     bool
+	Groups      []MeshGroup
+	Bounds      MeshBounds
+
+	data   []byte
+	mapped bool
+}
+
+var errInvalidMesh = errors.New("bgfx: invalid mesh container")
+
+// invalidHandle is idx of handle which doesn't refer to any resource.
+const invalidHandle = 0xffff
+
+// WriteMesh writes mesh container to w, indices is []uint16 or []uint32.
+// When groups is empty single group covering whole mesh is written,
+// otherwise only index and vertex ranges of groups are used and bounding
+// volumes are calculated from vertex positions.
+func WriteMesh(w io.Writer, decl VertexDecl, vertices interface{}, indices interface{}, groups []MeshGroup) error {
+	val := reflect.ValueOf(vertices)
+	switch {
+	case val.Kind() != reflect.Slice:
+		panic(errors.New("bgfx: expected slice"))
+	case decl.Stride() != int(val.Type().Elem().Size()):
+		panic(errors.New("bgfx: stride != slice element size"))
+	}
+	var idx unsafe.Pointer
+	var numIndices int
+	var index32 bool
+	switch i := indices.(type) {
+	case []uint16:
+		numIndices = len(i)
+		if numIndices != 0 {
+			idx = unsafe.Pointer(&i[0])
+		}
+	case []uint32:
+		numIndices = len(i)
+		index32 = true
+		if numIndices != 0 {
+			idx = unsafe.Pointer(&i[0])
+		}
+	default:
+		panic(errors.New("bgfx: expected []uint16 or []uint32"))
+	}
+	var cgroups *C.bgfx_mesh_group_t
+	if len(groups) != 0 {
+		gs := make([]C.bgfx_mesh_group_t, len(groups))
+		for i, g := range groups {
+			if g.StartIndex < 0 || g.NumIndices < 0 || g.StartIndex+g.NumIndices > numIndices ||
+				g.StartVertex < 0 || g.NumVertices < 0 || g.StartVertex+g.NumVertices > val.Len() {
+				panic(errors.New("bgfx: mesh group out of range"))
+			}
+			gs[i].startIndex = C.uint32_t(g.StartIndex)
+			gs[i].numIndices = C.uint32_t(g.NumIndices)
+			gs[i].startVertex = C.uint32_t(g.StartVertex)
+			gs[i].numVertices = C.uint32_t(g.NumVertices)
+		}
+		cgroups = &gs[0]
+	}
+	write := func(dst []byte) uint32 {
+		var ptr unsafe.Pointer
+		if len(dst) != 0 {
+			ptr = unsafe.Pointer(&dst[0])
+		}
+		return uint32(C.bgfx_mesh_write(
+			ptr,
+			C.uint32_t(len(dst)),
+			&decl.decl,
+			unsafe.Pointer(val.Pointer()),
+			C.uint32_t(val.Len()),
+			idx,
+			C.uint32_t(numIndices),
+			C.bool(index32),
+			cgroups,
+			C.uint32_t(len(groups)),
+		))
+	}
+	buf := make([]byte, write(nil))
+	write(buf)
+	_, err := w.Write(buf)
+	return err
+}
+
+// ParseMesh parses mesh container. Nothing is copied, mesh references
+// data.
+func ParseMesh(data []byte) (*Mesh, error) {
+	if len(data) == 0 || uint64(len(data)) > 0xffffffff {
+		return nil, errInvalidMesh
+	}
+	base := unsafe.Pointer(&data[0])
+	var info C.bgfx_mesh_info_t
+	if !C.bgfx_mesh_parse(&info, base, C.uint32_t(len(data))) {
+		return nil, errInvalidMesh
+	}
+	// offsets are kept instead of pointers into data, which
+	// is Go memory
+	offset := func(ptr unsafe.Pointer) int {
+		return int(uintptr(ptr) - uintptr(base))
+	}
+	indexSize := 2
+	if info.index32 {
+		indexSize = 4
+	}
+	m := &Mesh{
+		Decl:        VertexDecl{decl: info.decl},
+		NumVertices: int(info.numVertices),
+		NumIndices:  int(info.numIndices),
+		Index32:     bool(info.index32),
+		Groups:      make([]MeshGroup, int(info.numGroups)),
+		Bounds:      *(*MeshBounds)(unsafe.Pointer(&info.bounds)),
+		data:        data,
+	}
+	vertices := offset(info.vertices)
+	m.Vertices = data[vertices : vertices+m.NumVertices*m.Decl.Stride()]
+	indices := offset(info.indices)
+	m.Indices = data[indices : indices+m.NumIndices*indexSize]
+	groups := offset(unsafe.Pointer(info.groups))
+	for i := range m.Groups {
+		g := (*C.bgfx_mesh_group_t)(unsafe.Pointer(&data[groups+i*C.sizeof_bgfx_mesh_group_t]))
+		m.Groups[i] = MeshGroup{
+			StartIndex:  int(g.startIndex),
+			NumIndices:  int(g.numIndices),
+			StartVertex: int(g.startVertex),
+			NumVertices: int(g.numVertices),
+			Bounds:      *(*MeshBounds)(unsafe.Pointer(&g.bounds)),
+		}
+	}
+	return m, nil
+}
+
+// OpenMesh memory maps mesh container file. Mesh must be closed with
+// Close.
+func OpenMesh(path string) (*Mesh, error) {
+	data, err := mmapFile(path)
+	if err != nil {
+		return nil, err
+	}
+	m, err := ParseMesh(data)
+	if err != nil {
+		munmapFile(data)
+		return nil, err
+	}
+	// Without mmap data is read into Go memory, which bgfx can't keep
+	// references to, so it's copied by CreateBuffers instead.
+	m.mapped = mmapSupported
+	return m, nil
+}
+
+// Close unmaps memory mapped mesh, Vertices and Indices must not be used
+// after Close.
+func (m *Mesh) Close() error {
+	if !m.mapped {
+		return nil
+	}
+	data := m.data
+	*m = Mesh{}
+	return munmapFile(data)
+}
+
+// Indices16 returns Indices as 16-bit indices.
+func (m *Mesh) Indices16() (indices []uint16) {
+	if m.Index32 || m.NumIndices == 0 {
+		return nil
+	}
+	slice := (*reflect.SliceHeader)(unsafe.Pointer(&indices))
+	slice.Data = uintptr(unsafe.Pointer(&m.Indices[0]))
+	slice.Len = m.NumIndices
+	slice.Cap = m.NumIndices
+	return
+}
+
+// Indices32 returns Indices as 32-bit indices.
+func (m *Mesh) Indices32() (indices []uint32) {
+	if !m.Index32 || m.NumIndices == 0 {
+		return nil
+	}
+	slice := (*reflect.SliceHeader)(unsafe.Pointer(&indices))
+	slice.Data = uintptr(unsafe.Pointer(&m.Indices[0]))
+	slice.Len = m.NumIndices
+	slice.Cap = m.NumIndices
+	return
+}
+
+// CreateBuffers creates vertex and index buffer of mesh. Buffers of
+// memory mapped mesh reference file directly without copying, so mesh
+// must not be closed for at least as many frames after CreateBuffers as
+// init keeps in flight, two for Init, InitRenderer and InitWithLimits.
+// 32-bit indices require CapsIndex32. Mesh without vertices or indices
+// gets invalid buffer in their place, invalid index buffer draws
+// without indices, and destroying invalid buffer does nothing.
+func (m *Mesh) CreateBuffers() (VertexBuffer, IndexBuffer) {
+	mem := func(data []byte) *C.bgfx_memory_t {
+		if m.mapped {
+			return C.bgfx_make_ref(unsafe.Pointer(&data[0]), C.uint32_t(len(data)))
+		}
+		return C.bgfx_copy(unsafe.Pointer(&data[0]), C.uint32_t(len(data)))
+	}
+	flags := C.uint8_t(C.BGFX_BUFFER_NONE)
+	if m.Index32 {
+		flags = C.BGFX_BUFFER_INDEX32
+	}
+	vb := VertexBuffer{h: C.bgfx_vertex_buffer_handle_t{idx: invalidHandle}}
+	if len(m.Vertices) != 0 {
+		vb.h = C.bgfx_create_vertex_buffer(mem(m.Vertices), &m.Decl.decl)
+	}
+	ib := IndexBuffer{h: C.bgfx_index_buffer_handle_t{idx: invalidHandle}}
+	if len(m.Indices) != 0 {
+		ib.h = C.bgfx_create_index_buffer(mem(m.Indices), flags)
+	}
+	return vb, ib
+}
+
 type TextureFlags uint32
 
 const (
@@ -311,24 +1333,32 @@ const (
 )
 
 const (
-	TextureUShift       TextureFlags = 0
-	TextureVShift                    = 2
-	TextureWShift                    = 4
-	TextureMinShift                  = 6
-	TextureMagShift                  = 8
-	TextureMipShift                  = 10
-	TextureRTMSAAShift               = 12
-	TextureCompareShift              = 16
-
-	TextureUMask       = 0x03
-	TextureVMask       = 0x0c
-	TextureWMask       = 0x30
-	TextureMinMask     = 0xc0
-	TextureMagMask     = 0x300
-	TextureMipMask     = 0x400
-	TextureRTMSAAMask  = 0x7000
-	TextureRTMask      = 0xf000
-	TextureCompareMask = 0xf0000
+	TextureCompressBC1 TextureFlags = 0x00200000 + iota<<TextureCompressShift
+	TextureCompressBC3
+	TextureCompressETC1
+)
+
+const (
+	TextureUShift        TextureFlags = 0
+	TextureVShift                     = 2
+	TextureWShift                     = 4
+	TextureMinShift                   = 6
+	TextureMagShift                   = 8
+	TextureMipShift                   = 10
+	TextureRTMSAAShift                = 12
+	TextureCompareShift               = 16
+	TextureCompressShift              = 21
+
+	TextureUMask        = 0x03
+	TextureVMask        = 0x0c
+	TextureWMask        = 0x30
+	TextureMinMask      = 0xc0
+	TextureMagMask      = 0x300
+	TextureMipMask      = 0x400
+	TextureRTMSAAMask   = 0x7000
+	TextureRTMask       = 0xf000
+	TextureCompareMask  = 0xf0000
+	TextureCompressMask = 0x600000
 
 	TextureSamplerBitsMask = 0 |
 		TextureUMask |
@@ -442,6 +1472,129 @@ func CalcTextureSize(width, height, depth, numMips int, format TextureFormat) Te
 	return newTextureInfo(ti)
 }
 
+type MipsFlags uint32
+
+const (
+	MipsFilterBox     MipsFlags = 0x00000000
+	MipsFilterKaiser            = 0x00000001
+	MipsSRGB                    = 0x00000002
+	MipsAlphaCoverage           = 0x00000004
+)
+
+// ImageNumMips returns number of levels in full mip chain of image.
+func ImageNumMips(width, height int) int {
+	size := width
+	if height > size {
+		size = height
+	}
+	n := 1
+	for ; size > 1; size >>= 1 {
+		n++
+	}
+	return n
+}
+
+// ImageGenerateMips returns all mip levels of 4 byte per pixel image src
+// with rows pitch bytes apart, top level first, in layout expected by
+// CreateTexture2D. Level count is ImageNumMips(width, height). Width and
+// height are up to 65535. Must be called between Init and Shutdown.
+func ImageGenerateMips(src []byte, width, height, pitch int, flags MipsFlags, alphaRef float32) []byte {
+	if width <= 0 || height <= 0 || width > 0xffff || height > 0xffff ||
+		pitch < width*4 || len(src) < pitch*height {
+		panic(errImageSize)
+	}
+	ti := CalcTextureSize(width, height, 1, ImageNumMips(width, height), TextureFormatBGRA8)
+	dst := make([]byte, ti.StorageSize)
+	C.bgfx_image_generate_mip_chain(
+		unsafe.Pointer(&dst[0]),
+		C.uint32_t(width),
+		C.uint32_t(height),
+		C.uint32_t(pitch),
+		unsafe.Pointer(&src[0]),
+		C.uint32_t(flags),
+		C.float(alphaRef),
+	)
+	return dst
+}
+
+// ImageRGBA8Downsample2x2 writes src downsampled to half width and height
+// into dst, filtering with gamma 2.2.
+func ImageRGBA8Downsample2x2(dst, src []byte, width, height, pitch int) {
+	if width < 2 || height < 2 || pitch < width*4 ||
+		len(src) < pitch*height ||
+		len(dst) < width/2*(height/2)*4 {
+		panic(errImageSize)
+	}
+	C.bgfx_image_rgba8_downsample_2x2(
+		C.uint32_t(width),
+		C.uint32_t(height),
+		C.uint32_t(pitch),
+		unsafe.Pointer(&src[0]),
+		unsafe.Pointer(&dst[0]),
+	)
+}
+
+// imageBlockSize returns size in bytes of 4x4 block of compressed format,
+// or 0 when format isn't block compressed.
+func imageBlockSize(format TextureFormat) int {
+	switch format {
+	case TextureFormatBC1, TextureFormatBC4, TextureFormatETC1, TextureFormatETC2, TextureFormatETC2A1:
+		return 8
+	case TextureFormatBC2, TextureFormatBC3, TextureFormatBC5, TextureFormatBC6H, TextureFormatBC7, TextureFormatETC2A:
+		return 16
+	}
+	return 0
+}
+
+var errImageSize = errors.New("bgfx: image buffer too small")
+
+// ImageEncodeFromBGRA8 encodes BGRA8 image src with rows pitch bytes apart
+// into dst. Supported formats are BC1, BC3 and ETC1, it returns false for
+// others. dst must hold all 4x4 blocks covering the image.
+func ImageEncodeFromBGRA8(dst, src []byte, width, height, pitch int, format TextureFormat) bool {
+	switch format {
+	case TextureFormatBC1, TextureFormatBC3, TextureFormatETC1:
+	default:
+		return false
+	}
+	if width <= 0 || height <= 0 || pitch < width*4 ||
+		len(src) < pitch*height ||
+		len(dst) < (width+3)/4*((height+3)/4)*imageBlockSize(format) {
+		panic(errImageSize)
+	}
+	return bool(C.bgfx_image_encode_from_bgra8(
+		unsafe.Pointer(&dst[0]),
+		unsafe.Pointer(&src[0]),
+		C.uint32_t(width),
+		C.uint32_t(height),
+		C.uint32_t(pitch),
+		C.bgfx_texture_format_t(format),
+	))
+}
+
+// ImageDecodeToBGRA8 decodes block compressed image src into BGRA8 image
+// dst with rows pitch bytes apart. Formats without decoder are filled
+// with checkerboard.
+func ImageDecodeToBGRA8(dst, src []byte, width, height, pitch int, format TextureFormat) {
+	if width <= 0 || height <= 0 || pitch < width*4 ||
+		len(dst) < pitch*height ||
+		len(src) < width/4*(height/4)*imageBlockSize(format) {
+		panic(errImageSize)
+	}
+	var srcPtr unsafe.Pointer
+	if len(src) != 0 {
+		srcPtr = unsafe.Pointer(&src[0])
+	}
+	C.bgfx_image_decode_to_bgra8(
+		unsafe.Pointer(&dst[0]),
+		srcPtr,
+		C.uint32_t(width),
+		C.uint32_t(height),
+		C.uint32_t(pitch),
+		C.bgfx_texture_format_t(format),
+	)
+}
+
 func UpdateTextureCube(t Texture, side, mip, x, y, width, height int, data []byte, pitch int) {
 	if pitch == 0 {
 		pitch = 0xffff
@@ -491,6 +1644,28 @@ func DestroyFrameBuffer(fb FrameBuffer) {
 	C.bgfx_destroy_frame_buffer(fb.h)
 }
 
+var errViewRange = errors.New("bgfx: invalid view range")
+
+// AllocTransientFrameBuffer returns a pooled frame buffer valid for views
+// firstView to lastView of the current frame only. Requests with the same
+// size, format and flags whose view ranges don't overlap share the same
+// textures, so content is undefined at firstView. Transient frame buffers
+// must not be destroyed.
+func AllocTransientFrameBuffer(width, height int, format TextureFormat, flags TextureFlags, firstView, lastView ViewID) FrameBuffer {
+	if firstView < 0 || firstView > lastView {
+		panic(errViewRange)
+	}
+	h := C.bgfx_alloc_transient_frame_buffer(
+		C.uint16_t(width),
+		C.uint16_t(height),
+		C.bgfx_texture_format_t(format),
+		C.uint8_t(firstView),
+		C.uint8_t(lastView),
+		C.uint32_t(flags),
+	)
+	return FrameBuffer{h: h}
+}
+
 type Attrib uint8
 
 const (
@@ -571,16 +1746,30 @@ func CreateVertexBuffer(slice interface{}, decl VertexDecl) VertexBuffer {
 		panic(errors.New("bgfx: expected slice"))
 	}
 	size := uintptr(val.Len()) * val.Type().Elem().Size()
+	return createVertexBuffer(unsafe.Pointer(val.Pointer()), int(size), &decl)
+}
+
+// CreateVertexBufferBytes is like CreateVertexBuffer, but without
+// reflection, vertex data is raw bytes. Empty data returns invalid
+// handle.
+func CreateVertexBufferBytes(data []byte, decl VertexDecl) VertexBuffer {
+	if len(data) == 0 {
+		return VertexBuffer{h: C.bgfx_vertex_buffer_handle_t{idx: invalidHandle}}
+	}
+	return createVertexBuffer(unsafe.Pointer(&data[0]), len(data), &decl)
+}
+
+func createVertexBuffer(data unsafe.Pointer, size int, decl *VertexDecl) VertexBuffer {
 	return VertexBuffer{
-		h: C.bgfx_create_vertex_buffer(
-			// to keep things simple for now, we'll just copy
-			C.bgfx_copy(unsafe.Pointer(val.Pointer()), C.uint32_t(size)),
-			&decl.decl,
-		),
+		// to keep things simple for now, we'll just copy
+		h: C.bgfx_create_vertex_buffer_val(data, C.uint32_t(size), decl.decl),
 	}
 }
 
 func DestroyVertexBuffer(vb VertexBuffer) {
+	if vb.h.idx == invalidHandle {
+		return
+	}
 	C.bgfx_destroy_vertex_buffer(vb.h)
 }
 
@@ -588,19 +1777,140 @@ type IndexBuffer struct {
 	h C.bgfx_index_buffer_handle_t
 }
 
+var errEmptyIndexBuffer = errors.New("bgfx: empty index buffer")
+
 func CreateIndexBuffer(data []uint16) IndexBuffer {
+	if len(data) == 0 {
+		panic(errEmptyIndexBuffer)
+	}
 	return IndexBuffer{
 		h: C.bgfx_create_index_buffer(
 			// to keep things simple for now, we'll just copy
 			C.bgfx_copy(unsafe.Pointer(&data[0]), C.uint32_t(len(data)*2)),
+			C.BGFX_BUFFER_NONE,
+		),
+	}
+}
+
+// CreateIndexBuffer32 creates index buffer with 32-bit indices, which
+// can address more than 65535 vertices. Requires CapsIndex32.
+func CreateIndexBuffer32(data []uint32) IndexBuffer {
+	if len(data) == 0 {
+		panic(errEmptyIndexBuffer)
+	}
+	return IndexBuffer{
+		h: C.bgfx_create_index_buffer(
+			C.bgfx_copy(unsafe.Pointer(&data[0]), C.uint32_t(len(data)*4)),
+			C.BGFX_BUFFER_INDEX32,
 		),
 	}
 }
 
 func DestroyIndexBuffer(ib IndexBuffer) {
+	if ib.h.idx == invalidHandle {
+		return
+	}
 	C.bgfx_destroy_index_buffer(ib.h)
 }
 
+type DynamicVertexBuffer struct {
+	h C.bgfx_dynamic_vertex_buffer_handle_t
+}
+
+// CreateDynamicVertexBuffer creates vertex buffer for num vertices which
+// can be updated with UpdateDynamicVertexBuffer.
+func CreateDynamicVertexBuffer(num int, decl VertexDecl) DynamicVertexBuffer {
+	return DynamicVertexBuffer{
+		h: C.bgfx_create_dynamic_vertex_buffer(C.uint16_t(num), &decl.decl),
+	}
+}
+
+// UpdateDynamicVertexBuffer copies slice of vertices into vb starting at
+// startVertex. Updates of the same buffer within a frame are merged when
+// they overlap or touch.
+func UpdateDynamicVertexBuffer(vb DynamicVertexBuffer, startVertex int, slice interface{}) {
+	val := reflect.ValueOf(slice)
+	if val.Kind() != reflect.Slice {
+		panic(errors.New("bgfx: expected slice"))
+	}
+	size := uintptr(val.Len()) * val.Type().Elem().Size()
+	updateDynamicVertexBuffer(vb, startVertex, unsafe.Pointer(val.Pointer()), int(size))
+}
+
+// UpdateDynamicVertexBufferBytes is like UpdateDynamicVertexBuffer, but
+// without reflection, vertex data is raw bytes.
+func UpdateDynamicVertexBufferBytes(vb DynamicVertexBuffer, startVertex int, data []byte) {
+	if len(data) == 0 {
+		return
+	}
+	updateDynamicVertexBuffer(vb, startVertex, unsafe.Pointer(&data[0]), len(data))
+}
+
+func updateDynamicVertexBuffer(vb DynamicVertexBuffer, startVertex int, data unsafe.Pointer, size int) {
+	if size == 0 {
+		return
+	}
+	C.bgfx_update_dynamic_vertex_buffer_range(
+		vb.h,
+		C.uint32_t(startVertex),
+		C.bgfx_copy(data, C.uint32_t(size)),
+	)
+}
+
+func DestroyDynamicVertexBuffer(vb DynamicVertexBuffer) {
+	C.bgfx_destroy_dynamic_vertex_buffer(vb.h)
+}
+
+type DynamicIndexBuffer struct {
+	h C.bgfx_dynamic_index_buffer_handle_t
+}
+
+// CreateDynamicIndexBuffer creates 16-bit index buffer for num indices
+// which can be updated with UpdateDynamicIndexBuffer.
+func CreateDynamicIndexBuffer(num int) DynamicIndexBuffer {
+	return DynamicIndexBuffer{
+		h: C.bgfx_create_dynamic_index_buffer(C.uint32_t(num), C.BGFX_BUFFER_NONE),
+	}
+}
+
+// CreateDynamicIndexBuffer32 is like CreateDynamicIndexBuffer, but with
+// 32-bit indices. Requires CapsIndex32.
+func CreateDynamicIndexBuffer32(num int) DynamicIndexBuffer {
+	return DynamicIndexBuffer{
+		h: C.bgfx_create_dynamic_index_buffer(C.uint32_t(num), C.BGFX_BUFFER_INDEX32),
+	}
+}
+
+// UpdateDynamicIndexBuffer copies data into 16-bit index buffer ib
+// starting at startIndex.
+func UpdateDynamicIndexBuffer(ib DynamicIndexBuffer, startIndex int, data []uint16) {
+	if len(data) == 0 {
+		return
+	}
+	C.bgfx_update_dynamic_index_buffer_range(
+		ib.h,
+		C.uint32_t(startIndex),
+		C.bgfx_copy(unsafe.Pointer(&data[0]), C.uint32_t(len(data)*2)),
+	)
+}
+
+// UpdateDynamicIndexBuffer32 copies data into 32-bit index buffer ib
+// starting at startIndex.
+func UpdateDynamicIndexBuffer32(ib DynamicIndexBuffer, startIndex int, data []uint32) {
+	if len(data) == 0 {
+		return
+	}
+	C.bgfx_update_dynamic_index_buffer_range(
+		ib.h,
+		C.uint32_t(startIndex),
+		C.bgfx_copy(unsafe.Pointer(&data[0]), C.uint32_t(len(data)*4)),
+	)
+}
+
+func DestroyDynamicIndexBuffer(ib DynamicIndexBuffer) {
+	C.bgfx_destroy_dynamic_index_buffer(ib.h)
+}
+
 type TransientVertexBuffer struct {
 	tvb C.bgfx_transient_vertex_buffer_t
 }
@@ -610,16 +1920,23 @@ func AllocTransientVertexBuffer(data interface{}, size int, decl VertexDecl) Tra
 	if val.Kind() != reflect.Ptr || val.Elem().Kind() != reflect.Slice {
 		panic(errors.New("bgfx: expected pointer to slice"))
 	}
-	var tvb TransientVertexBuffer
-	C.bgfx_alloc_transient_vertex_buffer(
-		&tvb.tvb,
-		C.uint32_t(size),
-		&decl.decl,
-	)
-	slice := (*reflect.SliceHeader)(unsafe.Pointer(val.Pointer()))
+	return allocTransientVertexBuffer(unsafe.Pointer(val.Pointer()), size, size, &decl)
+}
+
+// AllocTransientVertexBufferBytes is like AllocTransientVertexBuffer, but
+// without reflection, buf is set to raw bytes of num vertices.
+func AllocTransientVertexBufferBytes(buf *[]byte, num int, decl VertexDecl) TransientVertexBuffer {
+	return allocTransientVertexBuffer(unsafe.Pointer(buf), num, num*decl.Stride(), &decl)
+}
+
+func allocTransientVertexBuffer(buf unsafe.Pointer, num, bufLen int, decl *VertexDecl) TransientVertexBuffer {
+	tvb := TransientVertexBuffer{
+		tvb: C.bgfx_alloc_transient_vertex_buffer_val(C.uint32_t(num), decl.decl),
+	}
+	slice := (*reflect.SliceHeader)(buf)
 	slice.Data = uintptr(unsafe.Pointer(tvb.tvb.data))
-	slice.Len = size
-	slice.Cap = size
+	slice.Len = bufLen
+	slice.Cap = bufLen
 	return tvb
 }
 
@@ -628,12 +1945,23 @@ type TransientIndexBuffer struct {
 }
 
 func AllocTransientIndexBuffer(buf *[]uint16, num int) TransientIndexBuffer {
+	return allocTransientIndexBuffer(unsafe.Pointer(buf), num, false)
+}
+
+// AllocTransientIndexBuffer32 is like AllocTransientIndexBuffer, but
+// with 32-bit indices. Requires CapsIndex32.
+func AllocTransientIndexBuffer32(buf *[]uint32, num int) TransientIndexBuffer {
+	return allocTransientIndexBuffer(unsafe.Pointer(buf), num, true)
+}
+
+func allocTransientIndexBuffer(buf unsafe.Pointer, num int, index32 bool) TransientIndexBuffer {
 	var tib TransientIndexBuffer
 	C.bgfx_alloc_transient_index_buffer(
 		&tib.tib,
 		C.uint32_t(num),
+		C.bool(index32),
 	)
-	slice := (*reflect.SliceHeader)(unsafe.Pointer(buf))
+	slice := (*reflect.SliceHeader)(buf)
 	slice.Data = uintptr(unsafe.Pointer(tib.tib.data))
 	slice.Len = num
 	slice.Cap = num
@@ -641,25 +1969,45 @@ func AllocTransientIndexBuffer(buf *[]uint16, num int) TransientIndexBuffer {
 }
 
 func AllocTransientBuffers(verts interface{}, idxs *[]uint16, decl VertexDecl, numVerts, numIndices int) (tvb TransientVertexBuffer, tib TransientIndexBuffer, ok bool) {
+	return allocTransientBuffers(verts, unsafe.Pointer(idxs), decl, numVerts, numIndices, false)
+}
+
+// AllocTransientBuffersBytes is like AllocTransientBuffers, but without
+// reflection, verts is set to raw bytes of numVerts vertices.
+func AllocTransientBuffersBytes(verts *[]byte, idxs *[]uint16, decl VertexDecl, numVerts, numIndices int) (tvb TransientVertexBuffer, tib TransientIndexBuffer, ok bool) {
+	return allocTransientBuffersPtr(unsafe.Pointer(verts), numVerts*decl.Stride(), unsafe.Pointer(idxs), &decl, numVerts, numIndices, false)
+}
+
+// AllocTransientBuffers32 is like AllocTransientBuffers, but with 32-bit
+// indices, so numVerts can be larger than 65535. Requires CapsIndex32.
+func AllocTransientBuffers32(verts interface{}, idxs *[]uint32, decl VertexDecl, numVerts, numIndices int) (tvb TransientVertexBuffer, tib TransientIndexBuffer, ok bool) {
+	return allocTransientBuffers(verts, unsafe.Pointer(idxs), decl, numVerts, numIndices, true)
+}
+
+func allocTransientBuffers(verts interface{}, idxs unsafe.Pointer, decl VertexDecl, numVerts, numIndices int, index32 bool) (tvb TransientVertexBuffer, tib TransientIndexBuffer, ok bool) {
 	val := reflect.ValueOf(verts)
 	if val.Kind() != reflect.Ptr || val.Elem().Kind() != reflect.Slice {
 		panic(errors.New("bgfx: expected pointer to slice"))
 	}
-	ok = bool(C.bgfx_alloc_transient_buffers(
-		&tvb.tvb,
-		&decl.decl,
-		C.uint16_t(numVerts),
-		&tib.tib,
-		C.uint16_t(numIndices),
-	))
+	return allocTransientBuffersPtr(unsafe.Pointer(val.Pointer()), numVerts, idxs, &decl, numVerts, numIndices, index32)
+}
+
+func allocTransientBuffersPtr(verts unsafe.Pointer, vertsLen int, idxs unsafe.Pointer, decl *VertexDecl, numVerts, numIndices int, index32 bool) (tvb TransientVertexBuffer, tib TransientIndexBuffer, ok bool) {
+	tb := C.bgfx_alloc_transient_buffers_val(
+		decl.decl,
+		C.uint32_t(numVerts),
+		C.uint32_t(numIndices),
+		C.bool(index32),
+	)
+	tvb.tvb, tib.tib, ok = tb.tvb, tb.tib, bool(tb.ok)
 	if !ok {
 		return
 	}
-	slice := (*reflect.SliceHeader)(unsafe.Pointer(val.Pointer()))
+	slice := (*reflect.SliceHeader)(verts)
 	slice.Data = uintptr(unsafe.Pointer(tvb.tvb.data))
-	slice.Len = numVerts
-	slice.Cap = numVerts
-	slice = (*reflect.SliceHeader)(unsafe.Pointer(idxs))
+	slice.Len = vertsLen
+	slice.Cap = vertsLen
+	slice = (*reflect.SliceHeader)(idxs)
 	slice.Data = uintptr(unsafe.Pointer(tib.tib.data))
 	slice.Len = numIndices
 	slice.Cap = numIndices
@@ -742,6 +2090,16 @@ const (
 	ClearStencil
 )
 
+// AttachmentOptions selects frame buffer attachments for
+// SetViewAttachmentHints.
+type AttachmentOptions uint8
+
+const (
+	AttachmentColor AttachmentOptions = 1 << iota
+	AttachmentDepth
+	AttachmentStencil
+)
+
 func SetViewRect(view ViewID, x, y, w, h int) {
 	C.bgfx_set_view_rect(
 		C.uint8_t(view),
@@ -753,10 +2111,10 @@ func SetViewRect(view ViewID, x, y, w, h int) {
 }
 
 func SetViewTransform(viewID ViewID, view, proj [16]float32) {
-	C.bgfx_set_view_transform(
+	C.bgfx_set_view_transform_val(
 		C.uint8_t(viewID),
-		unsafe.Pointer(&view[0]),
-		unsafe.Pointer(&proj[0]),
+		*(*C.bgfx_mtx_t)(unsafe.Pointer(&view)),
+		*(*C.bgfx_mtx_t)(unsafe.Pointer(&proj)),
 	)
 }
 
@@ -770,6 +2128,18 @@ func SetViewClear(view ViewID, clear ClearOptions, rgba uint32, depth float32, s
 	)
 }
 
+// SetViewAttachmentHints tells renderer which attachments of view don't
+// need to be loaded at the start of view, and which don't need to be
+// stored at the end of it. It saves frame buffer memory traffic on tiled
+// GPUs. Hints are ignored where renderer can't use them.
+func SetViewAttachmentHints(view ViewID, dontCare, discard AttachmentOptions) {
+	C.bgfx_set_view_attachment_hints(
+		C.uint8_t(view),
+		C.uint8_t(dontCare),
+		C.uint8_t(discard),
+	)
+}
+
 func SetViewFrameBuffer(view ViewID, fb FrameBuffer) {
 	C.bgfx_set_view_frame_buffer(
 		C.uint8_t(view),
@@ -845,7 +2215,7 @@ func StateBlendAlpha() State {
 }
 
 func SetTransform(mtx [16]float32) {
-	C.bgfx_set_transform(unsafe.Pointer(&mtx[0]), 1)
+	C.bgfx_set_transform_val(*(*C.bgfx_mtx_t)(unsafe.Pointer(&mtx)))
 }
 
 func SetProgram(prog Program) {
@@ -857,15 +2227,23 @@ func SetVertexBuffer(vb VertexBuffer) {
 }
 
 func SetTransientVertexBuffer(tvb TransientVertexBuffer, start, num int) {
-	C.bgfx_set_transient_vertex_buffer(&tvb.tvb, C.uint32_t(start), C.uint32_t(num))
+	C.bgfx_set_transient_vertex_buffer_val(tvb.tvb, C.uint32_t(start), C.uint32_t(num))
+}
+
+func SetDynamicVertexBuffer(vb DynamicVertexBuffer, num int) {
+	C.bgfx_set_dynamic_vertex_buffer(vb.h, C.uint32_t(num))
 }
 
 func SetIndexBuffer(ib IndexBuffer) {
 	C.bgfx_set_index_buffer(ib.h, 0, 0xffffffff)
 }
 
+func SetDynamicIndexBuffer(ib DynamicIndexBuffer, first, num int) {
+	C.bgfx_set_dynamic_index_buffer(ib.h, C.uint32_t(first), C.uint32_t(num))
+}
+
 func SetTransientIndexBuffer(tib TransientIndexBuffer, start, num int) {
-	C.bgfx_set_transient_index_buffer(&tib.tib, C.uint32_t(start), C.uint32_t(num))
+	C.bgfx_set_transient_index_buffer_val(tib.tib, C.uint32_t(start), C.uint32_t(num))
 }
 
 func SetInstanceDataBuffer(idb InstanceDataBuffer) {
@@ -877,6 +2255,16 @@ func SetUniform(u Uniform, ptr interface{}, num int) {
 	C.bgfx_set_uniform(u.h, unsafe.Pointer(val.Pointer()), C.uint16_t(num))
 }
 
+// SetUniformVec4 sets Uniform4fv uniform without reflection.
+func SetUniformVec4(u Uniform, v [4]float32) {
+	C.bgfx_set_uniform_vec4(u.h, *(*C.bgfx_vec4_t)(unsafe.Pointer(&v)))
+}
+
+// SetUniformMat4 sets Uniform4x4fv uniform without reflection.
+func SetUniformMat4(u Uniform, m [16]float32) {
+	C.bgfx_set_uniform_mtx(u.h, *(*C.bgfx_mtx_t)(unsafe.Pointer(&m)))
+}
+
 func SetTexture(stage uint8, u Uniform, t Texture) {
 	C.bgfx_set_texture(C.uint8_t(stage), u.h, t.h, C.UINT32_MAX)
 }
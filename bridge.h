@@ -9,3 +9,34 @@
 // serves as cgo's interface to bgfx_dbg_text_printf, since cgo does not
 // like varargs (wouldn't be typesafe).
 BGFX_C_API void bgfx_dbg_text_print(uint32_t x, uint32_t y, uint8_t attr, const char *text);
+
+// by value variants of hot calls. cgo makes every Go pointer passed to C
+// escape to heap, passing matrices, vertex decls and transient buffers by
+// value keeps them on Go stack.
+typedef struct bgfx_mtx
+{
+	float m[16];
+} bgfx_mtx_t;
+
+typedef struct bgfx_vec4
+{
+	float v[4];
+} bgfx_vec4_t;
+
+typedef struct bgfx_transient_buffers
+{
+	bgfx_transient_vertex_buffer_t tvb;
+	bgfx_transient_index_buffer_t tib;
+	bool ok;
+} bgfx_transient_buffers_t;
+
+BGFX_C_API uint32_t bgfx_set_transform_val(bgfx_mtx_t mtx);
+BGFX_C_API void bgfx_set_view_transform_val(uint8_t id, bgfx_mtx_t view, bgfx_mtx_t proj);
+BGFX_C_API void bgfx_set_uniform_vec4(bgfx_uniform_handle_t handle, bgfx_vec4_t value);
+BGFX_C_API void bgfx_set_uniform_mtx(bgfx_uniform_handle_t handle, bgfx_mtx_t value);
+BGFX_C_API bgfx_vertex_buffer_handle_t bgfx_create_vertex_buffer_val(const void *data, uint32_t size, bgfx_vertex_decl_t decl);
+BGFX_C_API bgfx_transient_vertex_buffer_t bgfx_alloc_transient_vertex_buffer_val(uint32_t num, bgfx_vertex_decl_t decl);
+BGFX_C_API bgfx_transient_buffers_t bgfx_alloc_transient_buffers_val(bgfx_vertex_decl_t decl, uint32_t num_vertices, uint32_t num_indices, bool index32);
+BGFX_C_API void bgfx_set_transient_vertex_buffer_val(bgfx_transient_vertex_buffer_t tvb, uint32_t start_vertex, uint32_t num_vertices);
+BGFX_C_API void bgfx_set_transient_index_buffer_val(bgfx_transient_index_buffer_t tib, uint32_t first_index, uint32_t num_indices);
+BGFX_C_API void bgfx_vertex_pack_val(bgfx_vec4_t input, bool normalized, bgfx_attrib_t attr, bgfx_vertex_decl_t decl, void *data, uint32_t index);
@@ -0,0 +1,524 @@
+package bgfx
+
+import (
+	"runtime"
+	"testing"
+)
+
+// benchNull runs fn against the NULL renderer. Frame is called every
+// frameEvery iterations so per-frame limits (draw calls, transient
+// memory) aren't exceeded, its cost is part of the measurement.
+func benchNull(b *testing.B, frameEvery int, fn func(i int)) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+	Frame()
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		fn(i)
+		if i%frameEvery == frameEvery-1 {
+			Frame()
+		}
+	}
+	b.StopTimer()
+	Frame()
+}
+
+func BenchmarkSubmit(b *testing.B) {
+	benchNull(b, 1000, func(i int) {
+		SetState(StateDefault)
+		Submit(0)
+	})
+}
+
+func BenchmarkSetTransform(b *testing.B) {
+	mtx := [16]float32{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}
+	benchNull(b, 1000, func(i int) {
+		mtx[12] = float32(i)
+		SetTransform(mtx)
+		Discard()
+	})
+}
+
+func BenchmarkSetUniform(b *testing.B) {
+	v := [4]float32{1, 2, 3, 4}
+	m := [16]float32{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}
+	bench := func(name string, typ UniformType, fn func(u Uniform)) {
+		b.Run(name, func(b *testing.B) {
+			var u Uniform
+			benchNull(b, 1000, func(i int) {
+				if i == 0 {
+					u = CreateUniform("u_bench", typ, 1)
+				}
+				fn(u)
+				Discard()
+			})
+		})
+	}
+	bench("reflect", Uniform4fv, func(u Uniform) { SetUniform(u, &v, 1) })
+	bench("vec4", Uniform4fv, func(u Uniform) { SetUniformVec4(u, v) })
+	bench("mat4", Uniform4x4fv, func(u Uniform) { SetUniformMat4(u, m) })
+}
+
+func BenchmarkCreateVertexBuffer(b *testing.B) {
+	decl := floatDecl()
+	verts := make([]floatVertex, 64)
+	data := make([]byte, len(verts)*decl.Stride())
+	b.Run("reflect", func(b *testing.B) {
+		benchNull(b, 100, func(i int) {
+			DestroyVertexBuffer(CreateVertexBuffer(verts, decl))
+		})
+	})
+	b.Run("bytes", func(b *testing.B) {
+		benchNull(b, 100, func(i int) {
+			DestroyVertexBuffer(CreateVertexBufferBytes(data, decl))
+		})
+	})
+}
+
+func BenchmarkAllocTransientVertexBuffer(b *testing.B) {
+	var verts []floatVertex
+	var data []byte
+	decl := floatDecl()
+	b.Run("reflect", func(b *testing.B) {
+		benchNull(b, 100, func(i int) {
+			tvb := AllocTransientVertexBuffer(&verts, 4, decl)
+			SetTransientVertexBuffer(tvb, 0, 4)
+			Discard()
+		})
+	})
+	b.Run("bytes", func(b *testing.B) {
+		benchNull(b, 100, func(i int) {
+			tvb := AllocTransientVertexBufferBytes(&data, 4, decl)
+			SetTransientVertexBuffer(tvb, 0, 4)
+			Discard()
+		})
+	})
+}
+
+func BenchmarkAllocTransientBuffers(b *testing.B) {
+	var verts []floatVertex
+	var data []byte
+	var idxs []uint16
+	decl := floatDecl()
+	b.Run("reflect", func(b *testing.B) {
+		benchNull(b, 100, func(i int) {
+			tvb, tib, _ := AllocTransientBuffers(&verts, &idxs, decl, 4, 6)
+			SetTransientVertexBuffer(tvb, 0, 4)
+			SetTransientIndexBuffer(tib, 0, 6)
+			Discard()
+		})
+	})
+	b.Run("bytes", func(b *testing.B) {
+		benchNull(b, 100, func(i int) {
+			tvb, tib, _ := AllocTransientBuffersBytes(&data, &idxs, decl, 4, 6)
+			SetTransientVertexBuffer(tvb, 0, 4)
+			SetTransientIndexBuffer(tib, 0, 6)
+			Discard()
+		})
+	})
+}
+
+func BenchmarkVertexPackSingle(b *testing.B) {
+	decl := floatDecl()
+	verts := make([]floatVertex, 1)
+	data := make([]byte, decl.Stride())
+	input := [4]float32{1, 2, 3, 4}
+	b.Run("reflect", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			VertexPack(input, false, AttribPosition, decl, verts, 0)
+		}
+	})
+	b.Run("bytes", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			VertexPackBytes(input, false, AttribPosition, decl, data, 0)
+		}
+	})
+}
+
+func TestBytesFastPaths(t *testing.T) {
+	decl := floatDecl()
+	verts := make([]floatVertex, 2)
+	data := make([]byte, 2*decl.Stride())
+	input := [4]float32{1, 2, 3, 4}
+	VertexPack(input, false, AttribColor0, decl, verts, 1)
+	VertexPackBytes(input, false, AttribColor0, decl, data, 1)
+	if got := VertexUnpack(AttribColor0, decl, data, 1); got != input {
+		t.Errorf("VertexPackBytes: unpacked %v, want %v", got, input)
+	}
+	if got := VertexUnpack(AttribColor0, decl, verts, 1); got != input {
+		t.Errorf("VertexPack: unpacked %v, want %v", got, input)
+	}
+	if vb := CreateVertexBufferBytes(nil, decl); vb.h.idx != invalidHandle {
+		t.Errorf("CreateVertexBufferBytes: empty data returned handle %d", vb.h.idx)
+	}
+
+	defer func() {
+		if recover() == nil {
+			t.Error("VertexPackBytes: expected panic on out of range index")
+		}
+	}()
+	VertexPackBytes(input, false, AttribColor0, decl, data, 2)
+}
+
+func TestDynamicBuffers(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	decl := floatDecl()
+	vb := CreateDynamicVertexBuffer(64, decl)
+	ib := CreateDynamicIndexBuffer(96)
+	ib32 := CreateDynamicIndexBuffer32(96)
+	Frame()
+
+	verts := testVertices(64)
+	for f := 0; f < 3; f++ {
+		UpdateDynamicVertexBuffer(vb, 0, verts[:16])
+		UpdateDynamicVertexBuffer(vb, 16, verts[16:20])
+		UpdateDynamicVertexBuffer(vb, 8, verts[8:12])
+		UpdateDynamicVertexBufferBytes(vb, 40, make([]byte, 4*decl.Stride()))
+		UpdateDynamicIndexBuffer(ib, 90, []uint16{0, 1, 2, 3, 4, 5})
+		UpdateDynamicIndexBuffer32(ib32, 0, []uint32{0, 1, 2})
+		// Empty updates are no-ops.
+		UpdateDynamicVertexBuffer(vb, 0, verts[:0])
+		UpdateDynamicVertexBufferBytes(vb, 0, nil)
+		UpdateDynamicIndexBuffer(ib, 0, nil)
+		UpdateDynamicIndexBuffer32(ib32, 0, []uint32{})
+
+		SetDynamicVertexBuffer(vb, 64)
+		SetDynamicIndexBuffer(ib, 90, 6)
+		Submit(0)
+		SetDynamicVertexBuffer(vb, 64)
+		SetDynamicIndexBuffer(ib32, 0, 3)
+		Submit(0)
+		Frame()
+	}
+
+	DestroyDynamicIndexBuffer(ib32)
+	DestroyDynamicIndexBuffer(ib)
+	DestroyDynamicVertexBuffer(vb)
+	Frame()
+}
+
+func TestIndex32(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	if Caps().Supported&CapsIndex32 == 0 {
+		t.Fatal("null renderer doesn't report CapsIndex32")
+	}
+
+	// More vertices than 16-bit indices can address.
+	const numVerts = 70000
+	decl := posNormalDecl()
+	ib := CreateIndexBuffer32([]uint32{0, numVerts / 2, numVerts - 1})
+	for f := 0; f < 2; f++ {
+		var verts []posNormalVertex
+		var indices []uint32
+		tvb, tib, ok := AllocTransientBuffers32(&verts, &indices, decl, numVerts, 6)
+		if !ok {
+			t.Fatal("AllocTransientBuffers32 failed")
+		}
+		if len(verts) != numVerts || len(indices) != 6 {
+			t.Fatalf("transient buffers hold %d vertices and %d indices", len(verts), len(indices))
+		}
+		copy(indices, []uint32{0, 1, 2, numVerts - 3, numVerts - 2, numVerts - 1})
+		SetTransientVertexBuffer(tvb, 0, numVerts)
+		SetTransientIndexBuffer(tib, 0, 6)
+		Submit(0)
+
+		var more []uint32
+		tib = AllocTransientIndexBuffer32(&more, 3)
+		if len(more) != 3 {
+			t.Fatalf("AllocTransientIndexBuffer32 returned %d indices", len(more))
+		}
+		copy(more, []uint32{numVerts - 1, 0, numVerts / 2})
+		SetTransientVertexBuffer(tvb, 0, numVerts)
+		SetTransientIndexBuffer(tib, 0, 3)
+		Submit(0)
+
+		SetTransientVertexBuffer(tvb, 0, numVerts)
+		SetIndexBuffer(ib)
+		Submit(0)
+		Frame()
+	}
+	DestroyIndexBuffer(ib)
+	Frame()
+
+	defer func() {
+		if recover() != errEmptyIndexBuffer {
+			t.Error("CreateIndexBuffer32(nil) didn't panic with errEmptyIndexBuffer")
+		}
+	}()
+	CreateIndexBuffer32(nil)
+}
+
+func TestBufferPoolTrim(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	// Four buffers fit into the default 3MB backing buffer, the fifth one
+	// spills into a second backing buffer.
+	decl := floatDecl()
+	const num = 16000
+	var vbs [5]DynamicVertexBuffer
+	for i := range vbs {
+		vbs[i] = CreateDynamicVertexBuffer(num, decl)
+	}
+	Frame()
+
+	_, stats := PoolStats()
+	if stats.NumBuffers != 2 || stats.NumAllocs != 5 {
+		t.Fatalf("pool after create: %+v", stats)
+	}
+
+	DestroyDynamicVertexBuffer(vbs[0])
+	Frame()
+
+	// Buffer already drawn in this frame stays in place, earlier draw
+	// would otherwise keep stale content of old range.
+	data := make([]byte, num*decl.Stride())
+	SetDynamicVertexBuffer(vbs[4], num)
+	Submit(0)
+	UpdateDynamicVertexBufferBytes(vbs[4], 0, data)
+	Frame()
+
+	_, stats = PoolStats()
+	if stats.NumRelocated != 0 {
+		t.Fatalf("buffer drawn in the same frame was relocated: %+v", stats)
+	}
+
+	UpdateDynamicVertexBufferBytes(vbs[4], 0, data)
+	SetDynamicVertexBuffer(vbs[4], num)
+	Submit(0)
+	Frame()
+
+	_, stats = PoolStats()
+	if stats.NumRelocated != 1 {
+		t.Fatalf("expected relocation out of sparse buffer: %+v", stats)
+	}
+
+	for i := 0; i < 20; i++ {
+		Frame()
+	}
+	_, stats = PoolStats()
+	if stats.NumBuffers != 1 || stats.NumReleased != 1 || stats.NumAllocs != 4 {
+		t.Fatalf("expected drained buffer to be released: %+v", stats)
+	}
+
+	for _, vb := range vbs[1:] {
+		DestroyDynamicVertexBuffer(vb)
+	}
+	for i := 0; i < 20; i++ {
+		Frame()
+	}
+	_, stats = PoolStats()
+	if stats.NumBuffers != 0 || stats.NumReleased != 2 || stats.Size != 0 {
+		t.Fatalf("expected empty pool: %+v", stats)
+	}
+}
+
+func TestTransientFrameBuffers(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	// Post-process chain: bright pass, blur in two passes and composite.
+	// Ping-pong targets whose view ranges don't overlap are aliased.
+	const flags = TextureUClamp | TextureVClamp
+	chain := func() [4]FrameBuffer {
+		var fbs [4]FrameBuffer
+		fbs[0] = AllocTransientFrameBuffer(160, 120, TextureFormatBGRA8, flags, 1, 2)
+		fbs[1] = AllocTransientFrameBuffer(160, 120, TextureFormatBGRA8, flags, 2, 3)
+		fbs[2] = AllocTransientFrameBuffer(160, 120, TextureFormatBGRA8, flags, 3, 4)
+		fbs[3] = AllocTransientFrameBuffer(320, 240, TextureFormatBGRA8, flags, 1, 4)
+		for i, fb := range fbs {
+			SetViewFrameBuffer(ViewID(i+1), fb)
+		}
+		return fbs
+	}
+
+	fbs := chain()
+	if fbs[0] != fbs[2] || fbs[0] == fbs[1] || fbs[0] == fbs[3] {
+		t.Fatalf("unexpected aliasing: %v", fbs)
+	}
+	Frame()
+
+	stats := TransientFrameBufferStats()
+	small, large := 160*120*4, 320*240*4
+	if stats.NumRequests != 4 || stats.NumFrameBuffers != 3 ||
+		stats.RequestedSize != 3*small+large || stats.AllocatedSize != 2*small+large {
+		t.Fatalf("pool after first frame: %+v", stats)
+	}
+
+	if next := chain(); next != fbs {
+		t.Fatalf("pooled frame buffers not reused: %v, want %v", next, fbs)
+	}
+	Frame()
+	if stats = TransientFrameBufferStats(); stats.NumCreated != 3 {
+		t.Fatalf("pool after second frame: %+v", stats)
+	}
+
+	for i := 0; i < 20; i++ {
+		Frame()
+	}
+	stats = TransientFrameBufferStats()
+	if stats.NumFrameBuffers != 0 || stats.NumReleased != 3 || stats.NumRequests != 0 {
+		t.Fatalf("expected unused frame buffers to be released: %+v", stats)
+	}
+
+	if fb := AllocTransientFrameBuffer(160, 120, TextureFormatBGRA8, flags, 0, 100); fb.h.idx != invalidHandle {
+		t.Errorf("view range past last view returned frame buffer %d", fb.h.idx)
+	}
+
+	defer func() {
+		if recover() != errViewRange {
+			t.Error("reversed view range didn't panic with errViewRange")
+		}
+	}()
+	AllocTransientFrameBuffer(160, 120, TextureFormatBGRA8, flags, 3, 2)
+}
+
+func TestInitWithLimits(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitWithLimits(RendererTypeNull, Limits{
+		MaxDrawCalls:    16,
+		MaxMatrixCache:  8,
+		TransientVBSize: 4 << 10,
+	})
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	limits := CurrentLimits()
+	if limits.MaxDrawCalls != 16 || limits.MaxMatrixCache != 8 ||
+		limits.TransientVBSize != 4<<10 || limits.TransientIBSize == 0 || limits.MaxRectCache == 0 {
+		t.Fatalf("limits: %+v", limits)
+	}
+	if caps := Caps(); caps.MaxDrawCalls != 16 {
+		t.Fatalf("caps max draw calls %d, want 16", caps.MaxDrawCalls)
+	}
+
+	decl := floatDecl()
+	var verts []byte
+	var idxs []uint16
+	num := (4 << 10) / decl.Stride()
+	if _, _, ok := AllocTransientBuffersBytes(&verts, &idxs, decl, num+1, 3); ok {
+		t.Fatal("transient vertex buffer larger than limit")
+	}
+
+	// Draw calls beyond limit are dropped.
+	for f := 0; f < 3; f++ {
+		for i := 0; i < 20; i++ {
+			tvb, tib, ok := AllocTransientBuffersBytes(&verts, &idxs, decl, 3, 3)
+			if !ok {
+				t.Fatal("failed to allocate transient buffers")
+			}
+			if i < limits.MaxMatrixCache-1 {
+				SetTransform(testIdentity)
+			}
+			SetTransientVertexBuffer(tvb, 0, 3)
+			SetTransientIndexBuffer(tib, 0, 3)
+			Submit(0)
+		}
+		Frame()
+
+		// Last draw call slot is reserved.
+		stats := Stats()
+		if stats.NumDraws != limits.MaxDrawCalls-1 || stats.NumDropped != 20-stats.NumDraws {
+			t.Fatalf("frame %d: %d draws, %d dropped", f, stats.NumDraws, stats.NumDropped)
+		}
+	}
+}
+
+func TestInitWithHandleLimits(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	// More textures than BGFX_CONFIG_MAX_TEXTURES default of 4096.
+	const numTextures = 5000
+	InitWithLimits(RendererTypeNull, Limits{MaxTextures: numTextures})
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	limits := CurrentLimits()
+	if limits.MaxTextures != numTextures || limits.MaxShaders == 0 || limits.MaxPrograms == 0 {
+		t.Fatalf("limits: %+v", limits)
+	}
+
+	// Library owns some texture handles, like the debug font.
+	var textures []Texture
+	for len(textures) <= numTextures {
+		tex := CreateTexture2D(1, 1, 1, TextureFormatBGRA8, 0, nil)
+		if tex.h.idx == invalidHandle {
+			break
+		}
+		textures = append(textures, tex)
+		if len(textures)%256 == 0 {
+			// Keep create commands within command buffer.
+			Frame()
+		}
+	}
+	if n := len(textures); n <= 4096 || n > numTextures {
+		t.Errorf("created %d textures, limit %d", n, numTextures)
+	}
+
+	for i, tex := range textures {
+		DestroyTexture(tex)
+		if i%256 == 255 {
+			Frame()
+		}
+	}
+	Frame()
+	Frame()
+
+	// Freed handles are reused.
+	tex := CreateTexture2D(1, 1, 1, TextureFormatBGRA8, 0, nil)
+	if tex.h.idx == invalidHandle {
+		t.Fatal("texture handle not reused after destroy")
+	}
+	DestroyTexture(tex)
+}
+
+func TestInitWithLimitsRange(t *testing.T) {
+	for _, limits := range []Limits{
+		{MaxDrawCalls: 65536},
+		{MaxRectCache: 65536},
+		{MaxTextures: 65536},
+		{MaxMatrixCache: -1},
+		{TransientVBSize: -1},
+	} {
+		func() {
+			defer func() {
+				if recover() != errLimitRange {
+					t.Errorf("%+v: expected errLimitRange panic", limits)
+				}
+			}()
+			InitWithLimits(RendererTypeNull, limits)
+			Shutdown()
+		}()
+	}
+}
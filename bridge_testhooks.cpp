@@ -0,0 +1,206 @@
+//go:build bgfx_test
+// +build bgfx_test
+
+// Hooks used only by tests and benchmarks, built with -tags bgfx_test.
+
+#include <bgfx.h>
+#include <bgfx.c99.h>
+#include "bridge_testhooks.h"
+
+
+#include <bx/jobsystem.h>
+#include "bgfx_p.h"
+
+static bx::CrtAllocator s_jobAllocator;
+
+static void jobEmpty(void* /*_userData*/) {
+}
+
+struct JobNested {
+	bx::JobSystem* js;
+	bx::JobCounter* counter;
+	uint32_t num;
+};
+
+// spawns children from a worker thread, so parent counter is decremented
+// by jobs that may have been stolen elsewhere.
+static void jobNestedParent(void* _userData) {
+	JobNested* nested = (JobNested*)_userData;
+	for (uint32_t ii = 0; ii < nested->num; ++ii) {
+		nested->js->run(jobEmpty, NULL, nested->counter);
+	}
+}
+
+struct JobKernel {
+	uint32_t* out;
+	uint32_t work;
+};
+
+static void jobKernel(void* _userData, uint32_t _start, uint32_t _end) {
+	JobKernel* kernel = (JobKernel*)_userData;
+	for (uint32_t ii = _start; ii < _end; ++ii) {
+		uint32_t hash = ii + 1;
+		for (uint32_t jj = 0; jj < kernel->work; ++jj) {
+			hash ^= hash << 13;
+			hash ^= hash >> 17;
+			hash ^= hash << 5;
+		}
+		kernel->out[ii] = hash;
+	}
+}
+
+BGFX_C_API void* bgfx_job_system_create(uint32_t num_threads) {
+	bx::JobSystem* js = BX_NEW(&s_jobAllocator, bx::JobSystem);
+	js->init(&s_jobAllocator, num_threads);
+	return js;
+}
+
+BGFX_C_API void bgfx_job_system_destroy(void *js) {
+	bx::JobSystem* system = (bx::JobSystem*)js;
+	system->shutdown();
+	BX_DELETE(&s_jobAllocator, system);
+}
+
+BGFX_C_API void bgfx_job_system_spawn(void *js, uint32_t num) {
+	bx::JobSystem* system = (bx::JobSystem*)js;
+	bx::JobCounter counter;
+	for (uint32_t ii = 0; ii < num; ++ii) {
+		system->run(jobEmpty, NULL, &counter);
+	}
+	system->wait(&counter);
+}
+
+BGFX_C_API void bgfx_job_system_spawn_nested(void *js, uint32_t num) {
+	bx::JobSystem* system = (bx::JobSystem*)js;
+	const uint32_t numParents = bx::uint32_max(1, num/64);
+	bx::JobCounter counter;
+	JobNested nested = { system, &counter, num/numParents };
+	for (uint32_t ii = 0; ii < numParents; ++ii) {
+		system->run(jobNestedParent, &nested, &counter);
+	}
+	system->wait(&counter);
+}
+
+BGFX_C_API uint32_t bgfx_job_system_parallel_for(void *js, uint32_t num, uint32_t grain, uint32_t work) {
+	bx::JobSystem* system = (bx::JobSystem*)js;
+	JobKernel kernel = { (uint32_t*)BX_ALLOC(&s_jobAllocator, num*sizeof(uint32_t) ), work };
+	system->parallelFor(num, grain, jobKernel, &kernel);
+
+	uint32_t sum = 0;
+	for (uint32_t ii = 0; ii < num; ++ii) {
+		sum += kernel.out[ii];
+	}
+
+	BX_FREE(&s_jobAllocator, kernel.out);
+	return sum;
+}
+
+BGFX_C_API void bgfx_job_system_stats(void *js, bgfx_job_stats_t *stats, int reset) {
+	bx::JobSystem* system = (bx::JobSystem*)js;
+	bx::JobStats jobStats;
+	system->getStats(jobStats);
+	stats->executed = jobStats.numExecuted;
+	stats->stolen = jobStats.numStolen;
+	stats->steal_attempts = jobStats.numStealAttempts;
+	stats->inlined = jobStats.numInlined;
+	if (reset) {
+		system->resetStats();
+	}
+}
+
+namespace bgfx {
+	extern bx::JobSystem* g_jobSystem;
+	uint16_t weldVerticesRef(uint16_t* _output, const VertexDecl& _decl, const void* _data, uint16_t _num, float _epsilon);
+}
+
+BGFX_C_API void bgfx_job_system_attach(void *js) {
+	bgfx::g_jobSystem = (bx::JobSystem*)js;
+}
+
+BGFX_C_API uint16_t bgfx_weld_vertices_ref(uint16_t* output, const bgfx_vertex_decl_t* decl, const void* data, uint16_t num, float epsilon) {
+	return bgfx::weldVerticesRef(output, *(const bgfx::VertexDecl*)decl, data, num, epsilon);
+}
+
+typedef bgfx::LruCacheT<uint32_t, uint32_t, BGFX_LRU_CACHE_TEST_KEYS> TestLruCache;
+static bx::CrtAllocator s_lruAllocator;
+
+BGFX_C_API void* bgfx_lru_cache_create() {
+	return BX_NEW(&s_lruAllocator, TestLruCache);
+}
+
+BGFX_C_API void bgfx_lru_cache_destroy(void* cache) {
+	BX_DELETE(&s_lruAllocator, (TestLruCache*)cache);
+}
+
+BGFX_C_API int bgfx_lru_cache_add(void* cache, uint32_t key, uint32_t hash, uint32_t value, uint32_t* evicted) {
+	return ((TestLruCache*)cache)->add(key, hash, value, *evicted);
+}
+
+BGFX_C_API int bgfx_lru_cache_find(void* cache, uint32_t key, uint32_t hash, uint32_t* value) {
+	uint32_t* found = ((TestLruCache*)cache)->find(key, hash);
+	if (NULL == found) {
+		return 0;
+	}
+	*value = *found;
+	return 1;
+}
+
+BGFX_C_API int bgfx_lru_cache_remove(void* cache, uint32_t hash, uint32_t* value) {
+	return ((TestLruCache*)cache)->remove(hash, *value);
+}
+
+BGFX_C_API int bgfx_lru_cache_evict(void* cache, uint32_t* value) {
+	return ((TestLruCache*)cache)->evict(*value);
+}
+
+BGFX_C_API void bgfx_lru_cache_stats(void* cache, bgfx_lru_cache_stats_t* stats) {
+	const TestLruCache* lru = (const TestLruCache*)cache;
+	stats->count = lru->getCount();
+	stats->hits = lru->getHits();
+	stats->misses = lru->getMisses();
+	stats->evictions = lru->getEvictions();
+}
+
+#if BX_PLATFORM_LINUX
+#include <bgfxplatform.h>
+
+static ::Display* s_testDisplay = NULL;
+static ::Window s_testWindow = 0;
+
+BGFX_C_API int bgfx_test_window_create(uint32_t width, uint32_t height) {
+	// GLX context creation locks display.
+	XInitThreads();
+	s_testDisplay = XOpenDisplay(NULL);
+	if (NULL == s_testDisplay) {
+		return 0;
+	}
+
+	int screen = DefaultScreen(s_testDisplay);
+	s_testWindow = XCreateSimpleWindow(s_testDisplay
+		, RootWindow(s_testDisplay, screen)
+		, 0, 0, width, height, 0
+		, BlackPixel(s_testDisplay, screen)
+		, BlackPixel(s_testDisplay, screen)
+		);
+	XMapWindow(s_testDisplay, s_testWindow);
+	XSync(s_testDisplay, False);
+
+	bgfx::x11SetDisplayWindow(s_testDisplay, s_testWindow);
+	return 1;
+}
+
+BGFX_C_API void bgfx_test_window_destroy() {
+	if (NULL != s_testDisplay) {
+		XDestroyWindow(s_testDisplay, s_testWindow);
+		XCloseDisplay(s_testDisplay);
+		s_testDisplay = NULL;
+	}
+}
+#else
+BGFX_C_API int bgfx_test_window_create(uint32_t /*width*/, uint32_t /*height*/) {
+	return 0;
+}
+
+BGFX_C_API void bgfx_test_window_destroy() {
+}
+#endif // BX_PLATFORM_LINUX
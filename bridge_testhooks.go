@@ -0,0 +1,154 @@
+//go:build bgfx_test
+// +build bgfx_test
+
+package bgfx
+
+// Hooks used only by tests and benchmarks. Test files can't use cgo, so
+// they live here, and are built only with -tags bgfx_test.
+
+/*
+#include "bgfx.c99.h"
+#include "bridge_testhooks.h"
+*/
+import "C"
+
+import (
+	"reflect"
+	"unsafe"
+)
+
+func weldVerticesRef(output []uint16, decl VertexDecl, slice interface{}, epsilon float32) int {
+	val := reflect.ValueOf(slice)
+	return int(C.bgfx_weld_vertices_ref(
+		(*C.uint16_t)(unsafe.Pointer(&output[0])),
+		&decl.decl,
+		unsafe.Pointer(val.Pointer()),
+		C.uint16_t(len(output)),
+		C.float(epsilon),
+	))
+}
+
+// jobSystem wraps a standalone bx::JobSystem for benchmarks, bgfx itself
+// creates its own at Init.
+type jobSystem struct {
+	js unsafe.Pointer
+}
+
+type jobStats struct {
+	Executed      uint64
+	Stolen        uint64
+	StealAttempts uint64
+	Inlined       uint64
+}
+
+func newJobSystem(numThreads int) jobSystem {
+	return jobSystem{js: C.bgfx_job_system_create(C.uint32_t(numThreads))}
+}
+
+// attach makes bgfx use the job system, f.e. for vertex welding.
+func (s jobSystem) attach() {
+	C.bgfx_job_system_attach(s.js)
+}
+
+func detachJobSystem() {
+	C.bgfx_job_system_attach(nil)
+}
+
+func (s jobSystem) destroy() {
+	C.bgfx_job_system_destroy(s.js)
+}
+
+func (s jobSystem) spawn(num int) {
+	C.bgfx_job_system_spawn(s.js, C.uint32_t(num))
+}
+
+func (s jobSystem) spawnNested(num int) {
+	C.bgfx_job_system_spawn_nested(s.js, C.uint32_t(num))
+}
+
+func (s jobSystem) parallelFor(num, grain, work int) uint32 {
+	return uint32(C.bgfx_job_system_parallel_for(s.js, C.uint32_t(num), C.uint32_t(grain), C.uint32_t(work)))
+}
+
+func (s jobSystem) stats(reset bool) jobStats {
+	var stats C.bgfx_job_stats_t
+	var r C.int
+	if reset {
+		r = 1
+	}
+	C.bgfx_job_system_stats(s.js, &stats, r)
+	return jobStats{
+		Executed:      uint64(stats.executed),
+		Stolen:        uint64(stats.stolen),
+		StealAttempts: uint64(stats.steal_attempts),
+		Inlined:       uint64(stats.inlined),
+	}
+}
+
+// lruCache wraps LruCacheT instance with BGFX_LRU_CACHE_TEST_KEYS
+// capacity.
+type lruCache struct {
+	c unsafe.Pointer
+}
+
+type lruCacheStats struct {
+	Count     int
+	Hits      int
+	Misses    int
+	Evictions int
+}
+
+const lruCacheTestKeys = C.BGFX_LRU_CACHE_TEST_KEYS
+
+func newLruCache() lruCache {
+	return lruCache{c: C.bgfx_lru_cache_create()}
+}
+
+func (l lruCache) destroy() {
+	C.bgfx_lru_cache_destroy(l.c)
+}
+
+func (l lruCache) add(key, hash, value uint32) (evicted uint32, full bool) {
+	var ev C.uint32_t
+	full = 0 != C.bgfx_lru_cache_add(l.c, C.uint32_t(key), C.uint32_t(hash), C.uint32_t(value), &ev)
+	return uint32(ev), full
+}
+
+func (l lruCache) find(key, hash uint32) (uint32, bool) {
+	var value C.uint32_t
+	ok := 0 != C.bgfx_lru_cache_find(l.c, C.uint32_t(key), C.uint32_t(hash), &value)
+	return uint32(value), ok
+}
+
+func (l lruCache) remove(hash uint32) (uint32, bool) {
+	var value C.uint32_t
+	ok := 0 != C.bgfx_lru_cache_remove(l.c, C.uint32_t(hash), &value)
+	return uint32(value), ok
+}
+
+func (l lruCache) evict() (uint32, bool) {
+	var value C.uint32_t
+	ok := 0 != C.bgfx_lru_cache_evict(l.c, &value)
+	return uint32(value), ok
+}
+
+func (l lruCache) stats() lruCacheStats {
+	var stats C.bgfx_lru_cache_stats_t
+	C.bgfx_lru_cache_stats(l.c, &stats)
+	return lruCacheStats{
+		Count:     int(stats.count),
+		Hits:      int(stats.hits),
+		Misses:    int(stats.misses),
+		Evictions: int(stats.evictions),
+	}
+}
+
+// createTestWindow creates window OpenGL renderer can be initialized
+// with, it returns false when there is no display.
+func createTestWindow(width, height int) bool {
+	return 0 != C.bgfx_test_window_create(C.uint32_t(width), C.uint32_t(height))
+}
+
+func destroyTestWindow() {
+	C.bgfx_test_window_destroy()
+}
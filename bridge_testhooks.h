@@ -0,0 +1,56 @@
+#ifndef BGFX_C_API
+#ifdef __cplusplus
+#define BGFX_C_API extern "C"
+#else
+#define BGFX_C_API
+#endif
+#endif
+
+// job system micro-benchmark hooks, a standalone job system is created so
+// benchmarks don't depend on bgfx_init.
+typedef struct bgfx_job_stats
+{
+	uint64_t executed;
+	uint64_t stolen;
+	uint64_t steal_attempts;
+	uint64_t inlined;
+} bgfx_job_stats_t;
+
+BGFX_C_API void* bgfx_job_system_create(uint32_t num_threads);
+BGFX_C_API void bgfx_job_system_destroy(void *js);
+BGFX_C_API void bgfx_job_system_spawn(void *js, uint32_t num);
+BGFX_C_API void bgfx_job_system_spawn_nested(void *js, uint32_t num);
+BGFX_C_API uint32_t bgfx_job_system_parallel_for(void *js, uint32_t num, uint32_t grain, uint32_t work);
+BGFX_C_API void bgfx_job_system_stats(void *js, bgfx_job_stats_t *stats, int reset);
+
+// bgfx uses job system only after bgfx_init, benchmarks attach standalone
+// job system instead, NULL detaches it.
+BGFX_C_API void bgfx_job_system_attach(void *js);
+
+// brute force vertex welding that bgfx_weld_vertices32 is tested against.
+BGFX_C_API uint16_t bgfx_weld_vertices_ref(uint16_t* output, const bgfx_vertex_decl_t* decl, const void* data, uint16_t num, float epsilon);
+
+// LruCacheT instance with uint32_t keys and values, small enough that
+// tests hit eviction and long probe sequences.
+#define BGFX_LRU_CACHE_TEST_KEYS 16
+
+typedef struct bgfx_lru_cache_stats
+{
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t evictions;
+} bgfx_lru_cache_stats_t;
+
+BGFX_C_API void* bgfx_lru_cache_create();
+BGFX_C_API void bgfx_lru_cache_destroy(void* cache);
+BGFX_C_API int bgfx_lru_cache_add(void* cache, uint32_t key, uint32_t hash, uint32_t value, uint32_t* evicted);
+BGFX_C_API int bgfx_lru_cache_find(void* cache, uint32_t key, uint32_t hash, uint32_t* value);
+BGFX_C_API int bgfx_lru_cache_remove(void* cache, uint32_t hash, uint32_t* value);
+BGFX_C_API int bgfx_lru_cache_evict(void* cache, uint32_t* value);
+BGFX_C_API void bgfx_lru_cache_stats(void* cache, bgfx_lru_cache_stats_t* stats);
+
+// creates X11 window for OpenGL renderer tests and hands it to bgfx,
+// returns 0 when there is no display (or platform is not X11).
+BGFX_C_API int bgfx_test_window_create(uint32_t width, uint32_t height);
+BGFX_C_API void bgfx_test_window_destroy();
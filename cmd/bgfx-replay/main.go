@@ -0,0 +1,83 @@
+// Command bgfx-replay replays a trace written by bgfx.RecordBegin with the
+// Null renderer and prints per-frame CPU timings. It needs neither a
+// window nor a GPU, so it can run as a regression benchmark on headless
+// CI machines. To replay with a real renderer, set up a window and call
+// bgfx.ReplayBegin and bgfx.ReplayFrame from the application instead.
+//
+// Usage:
+//
+//	bgfx-replay [-frames n] [-loop n] [-q] trace.bin
+package main
+
+import (
+	"flag"
+	"fmt"
+	"log"
+	"os"
+	"runtime"
+	"sort"
+	"time"
+
+	"github.com/james4k/go-bgfx"
+)
+
+var (
+	maxFrames = flag.Int("frames", 0, "replay at most `n` frames, 0 replays whole trace")
+	loops     = flag.Int("loop", 1, "replay trace `n` times")
+	quiet     = flag.Bool("q", false, "print summary only")
+)
+
+func main() {
+	log.SetFlags(0)
+	log.SetPrefix("bgfx-replay: ")
+	flag.Usage = func() {
+		fmt.Fprintf(os.Stderr, "usage: bgfx-replay [flags] trace.bin\n")
+		flag.PrintDefaults()
+	}
+	flag.Parse()
+	if flag.NArg() != 1 {
+		flag.Usage()
+		os.Exit(2)
+	}
+
+	runtime.LockOSThread()
+	bgfx.InitRenderer(bgfx.RendererTypeNull)
+	defer bgfx.Shutdown()
+
+	var issue, frame []time.Duration
+	for i := 0; i < *loops; i++ {
+		if err := bgfx.ReplayBegin(flag.Arg(0)); err != nil {
+			log.Fatal(err)
+		}
+		for n := 0; *maxFrames == 0 || n < *maxFrames; n++ {
+			stats, ok := bgfx.ReplayFrame()
+			if !ok {
+				break
+			}
+			if !*quiet {
+				fmt.Printf("frame %5d  calls %6d  submits %5d  issue %10v  frame %10v\n",
+					stats.Frame, stats.NumCalls, stats.NumSubmits, stats.IssueTime, stats.FrameTime)
+			}
+			issue = append(issue, stats.IssueTime)
+			frame = append(frame, stats.FrameTime)
+		}
+		bgfx.ReplayEnd()
+	}
+
+	if len(issue) == 0 {
+		log.Fatal("trace has no frames")
+	}
+	fmt.Printf("%d frames\n", len(issue))
+	summary("issue", issue)
+	summary("frame", frame)
+}
+
+func summary(name string, d []time.Duration) {
+	sort.Slice(d, func(i, j int) bool { return d[i] < d[j] })
+	var total time.Duration
+	for _, v := range d {
+		total += v
+	}
+	fmt.Printf("%s  min %10v  median %10v  p99 %10v  max %10v  mean %10v\n",
+		name, d[0], d[len(d)/2], d[len(d)*99/100], d[len(d)-1], total/time.Duration(len(d)))
+}
@@ -34,6 +34,14 @@ func TestConstClearOptions(t *testing.T) {
 	}
 }
 
+func TestConstAttachmentOptions(t *testing.T) {
+	for _, d := range attachmentOptionsTable {
+		if d.a != AttachmentOptions(d.b) {
+			t.Errorf("%d != %d", d.a, d.b)
+		}
+	}
+}
+
 func TestConstCapFlags(t *testing.T) {
 	for _, d := range capFlagsTable {
 		if d.a != CapFlags(d.b) {
@@ -97,3 +105,11 @@ func TestConstBlend(t *testing.T) {
 		}
 	}
 }
+
+func TestConstGLCall(t *testing.T) {
+	for _, d := range glCallTable {
+		if d.a != GLCall(d.b) {
+			t.Errorf("%d != %d", d.a, d.b)
+		}
+	}
+}
@@ -53,6 +53,15 @@ var clearOptionsTable = []struct {
 	{ClearStencil, C.BGFX_CLEAR_STENCIL_BIT},
 }
 
+var attachmentOptionsTable = []struct {
+	a AttachmentOptions
+	b C.uint8_t
+}{
+	{AttachmentColor, C.BGFX_ATTACHMENT_COLOR_BIT},
+	{AttachmentDepth, C.BGFX_ATTACHMENT_DEPTH_BIT},
+	{AttachmentStencil, C.BGFX_ATTACHMENT_STENCIL_BIT},
+}
+
 var capFlagsTable = []struct {
 	a CapFlags
 	b C.uint64_t
@@ -68,6 +77,7 @@ var capFlagsTable = []struct {
 	{CapsCompute, C.BGFX_CAPS_COMPUTE},
 	{CapsFragmentOrdering, C.BGFX_CAPS_FRAGMENT_ORDERING},
 	{CapsSwapChain, C.BGFX_CAPS_SWAP_CHAIN},
+	{CapsIndex32, C.BGFX_CAPS_INDEX32},
 }
 
 var uniformTypeTable = []struct {
@@ -228,6 +238,11 @@ var texFlagsTable = []struct {
 	{TextureCompareShift, C.BGFX_TEXTURE_COMPARE_SHIFT},
 	{TextureCompareMask, C.BGFX_TEXTURE_COMPARE_MASK},
 	{TextureComputeWrite, C.BGFX_TEXTURE_COMPUTE_WRITE},
+	{TextureCompressBC1, C.BGFX_TEXTURE_COMPRESS_BC1},
+	{TextureCompressBC3, C.BGFX_TEXTURE_COMPRESS_BC3},
+	{TextureCompressETC1, C.BGFX_TEXTURE_COMPRESS_ETC1},
+	{TextureCompressShift, C.BGFX_TEXTURE_COMPRESS_SHIFT},
+	{TextureCompressMask, C.BGFX_TEXTURE_COMPRESS_MASK},
 	//{TextureReservedShift, C.BGFX_TEXTURE_RESERVED_SHIFT},
 	//{TextureReservedMask, C.BGFX_TEXTURE_RESERVED_MASK},
 }
@@ -268,3 +283,21 @@ var blendTable = []struct {
 	{BlendFactor, C.BGFX_STATE_BLEND_FACTOR},
 	{BlendInvFactor, C.BGFX_STATE_BLEND_INV_FACTOR},
 }
+
+var glCallTable = []struct {
+	a GLCall
+	b C.bgfx_gl_call_t
+}{
+	{GLCallBindBuffer, C.BGFX_GL_CALL_BIND_BUFFER},
+	{GLCallBindTexture, C.BGFX_GL_CALL_BIND_TEXTURE},
+	{GLCallActiveTexture, C.BGFX_GL_CALL_ACTIVE_TEXTURE},
+	{GLCallUseProgram, C.BGFX_GL_CALL_USE_PROGRAM},
+	{GLCallBindFramebuffer, C.BGFX_GL_CALL_BIND_FRAMEBUFFER},
+	{GLCallBindVertexArray, C.BGFX_GL_CALL_BIND_VERTEX_ARRAY},
+	{GLCallBindSampler, C.BGFX_GL_CALL_BIND_SAMPLER},
+	{GLCallEnable, C.BGFX_GL_CALL_ENABLE},
+	{GLCallUniform, C.BGFX_GL_CALL_UNIFORM},
+	{GLCallDraw, C.BGFX_GL_CALL_DRAW},
+	{GLCallInvalidate, C.BGFX_GL_CALL_INVALIDATE},
+	{GLCallCount, C.BGFX_GL_CALL_COUNT},
+}
@@ -0,0 +1,153 @@
+package bgfx
+
+import (
+	"math"
+	"math/rand"
+	"testing"
+	"time"
+)
+
+// testViewProj is perspective projection with 90 degree field of view,
+// looking down +z from origin, in bx::mtxProj layout.
+func testViewProj(near, far float32) [16]float32 {
+	aa := far / (far - near)
+	return [16]float32{
+		0:  1,
+		5:  1,
+		10: aa,
+		11: 1,
+		14: -near * aa,
+	}
+}
+
+// testFrustumDist returns the smallest signed distance of point to
+// planes of testViewProj frustum.
+func testFrustumDist(near, far float32, x, y, z float32, ext [3]float32) float32 {
+	s := float32(1 / math.Sqrt2)
+	planes := [6][4]float32{
+		{s, 0, s, 0},
+		{-s, 0, s, 0},
+		{0, s, s, 0},
+		{0, -s, s, 0},
+		{0, 0, 1, -near},
+		{0, 0, -1, far},
+	}
+	dist := float32(math.MaxFloat32)
+	for _, p := range planes {
+		d := p[0]*x + p[1]*y + p[2]*z + p[3]
+		d += abs32(p[0])*ext[0] + abs32(p[1])*ext[1] + abs32(p[2])*ext[2]
+		if d < dist {
+			dist = d
+		}
+	}
+	return dist
+}
+
+func TestCullSpheres(t *testing.T) {
+	const near, far = 1, 100
+	viewProj := testViewProj(near, far)
+	rng := rand.New(rand.NewSource(1))
+	for _, n := range []int{1, 3, 4, 31, 32, 33, 100, 1027} {
+		x := make([]float32, n)
+		y := make([]float32, n)
+		z := make([]float32, n)
+		r := make([]float32, n)
+		for i := range x {
+			x[i] = rng.Float32()*240 - 120
+			y[i] = rng.Float32()*240 - 120
+			z[i] = rng.Float32()*240 - 120
+			r[i] = rng.Float32() * 10
+		}
+		visible := make([]uint32, (n+31)/32)
+		for i := range visible {
+			visible[i] = ^uint32(0)
+		}
+		CullSpheres(visible, viewProj, false, x, y, z, r)
+		for i := 0; i < n; i++ {
+			got := visible[i/32]&(1<<uint(i%32)) != 0
+			dist := testFrustumDist(near, far, x[i], y[i], z[i], [3]float32{})
+			if abs32(dist+r[i]) < 1e-3 {
+				continue
+			}
+			if want := dist+r[i] >= 0; got != want {
+				t.Fatalf("n=%d: sphere %d: visible=%v, want %v", n, i, got, want)
+			}
+		}
+		if rem := uint(n % 32); rem != 0 && visible[n/32]>>rem != 0 {
+			t.Errorf("n=%d: bits past last sphere are set: %#x", n, visible[n/32])
+		}
+	}
+}
+
+func TestCullAABBs(t *testing.T) {
+	const near, far = 1, 100
+	viewProj := testViewProj(near, far)
+	rng := rand.New(rand.NewSource(2))
+	const n = 517
+	var min, max [3][]float32
+	for k := range min {
+		min[k] = make([]float32, n)
+		max[k] = make([]float32, n)
+		for i := range min[k] {
+			c := rng.Float32()*240 - 120
+			e := rng.Float32() * 10
+			min[k][i] = c - e
+			max[k][i] = c + e
+		}
+	}
+	// Streams start off 16 byte alignment.
+	visible := make([]uint32, (n+31)/32)
+	CullAABBs(visible, viewProj, false,
+		min[0][1:], min[1][1:], min[2][1:],
+		max[0][1:], max[1][1:], max[2][1:])
+	for i := 0; i < n-1; i++ {
+		var c, e [3]float32
+		for k := range c {
+			c[k] = (min[k][i+1] + max[k][i+1]) * 0.5
+			e[k] = (max[k][i+1] - min[k][i+1]) * 0.5
+		}
+		got := visible[i/32]&(1<<uint(i%32)) != 0
+		dist := testFrustumDist(near, far, c[0], c[1], c[2], e)
+		if abs32(dist) < 1e-3 {
+			continue
+		}
+		if want := dist >= 0; got != want {
+			t.Fatalf("box %d: visible=%v, want %v", i, got, want)
+		}
+	}
+
+	// Box straddling near plane is visible, box behind camera isn't.
+	one := func(minZ, maxZ float32) bool {
+		var v [1]uint32
+		CullAABBs(v[:], viewProj, false,
+			[]float32{-1}, []float32{-1}, []float32{minZ},
+			[]float32{1}, []float32{1}, []float32{maxZ})
+		return v[0] == 1
+	}
+	if !one(0, 2) {
+		t.Error("box straddling near plane is culled")
+	}
+	if one(-3, -2) {
+		t.Error("box behind camera is visible")
+	}
+}
+
+func BenchmarkCullSpheres(b *testing.B) {
+	const n = 1 << 14
+	rng := rand.New(rand.NewSource(1))
+	var s [4][]float32
+	for k := range s {
+		s[k] = make([]float32, n)
+		for i := range s[k] {
+			s[k][i] = rng.Float32()*240 - 120
+		}
+	}
+	visible := make([]uint32, n/32)
+	viewProj := testViewProj(1, 100)
+	b.ResetTimer()
+	start := time.Now()
+	for i := 0; i < b.N; i++ {
+		CullSpheres(visible, viewProj, false, s[0], s[1], s[2], s[3])
+	}
+	b.ReportMetric(float64(time.Since(start).Nanoseconds())/float64(b.N*n), "ns/sphere")
+}
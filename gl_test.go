@@ -0,0 +1,90 @@
+//go:build bgfx_test
+// +build bgfx_test
+
+package bgfx
+
+import (
+	"runtime"
+	"testing"
+)
+
+// initGL initializes OpenGL renderer on test window, and skips test when
+// there is no display. Without GPU run it under Xvfb with llvmpipe:
+//
+//	LIBGL_ALWAYS_SOFTWARE=1 xvfb-run go test -tags bgfx_test -run GL -v
+func initGL(t *testing.T) {
+	runtime.LockOSThread()
+	if !createTestWindow(320, 240) {
+		runtime.UnlockOSThread()
+		t.Skip("no X display, run under xvfb-run")
+	}
+	InitRenderer(RendererTypeOpenGL)
+	Reset(320, 240, 0)
+	t.Cleanup(func() {
+		Shutdown()
+		destroyTestWindow()
+		runtime.UnlockOSThread()
+	})
+}
+
+func TestGLCallCounts(t *testing.T) {
+	initGL(t)
+
+	// Debug text blit draws with its own program, buffers and texture.
+	SetDebug(DebugText)
+	SetViewClear(0, ClearColor|ClearDepth, 0x303030ff, 1, 0)
+	SetViewRect(0, 0, 0, 320, 240)
+	var stats FrameStats
+	for f := 0; f < 4; f++ {
+		DebugTextClear()
+		DebugTextPrintf(0, 1, 0x4f, "frame %d", f)
+		Submit(0)
+		Frame()
+		stats = Stats()
+	}
+
+	for _, call := range []GLCall{GLCallBindBuffer, GLCallUseProgram, GLCallDraw} {
+		if stats.GLCalls[call] == 0 {
+			t.Errorf("GL call %d is not counted", call)
+		}
+	}
+	// Blit binds the same state every frame, shadow must filter some.
+	filtered := 0
+	for _, n := range stats.GLCallsFiltered {
+		filtered += n
+	}
+	t.Logf("GL calls %v, filtered %v", stats.GLCalls, stats.GLCallsFiltered)
+	if filtered == 0 {
+		t.Error("no GL calls were filtered")
+	}
+	if stats.NumVAOStates > 0 && stats.VAOHits == 0 {
+		t.Errorf("VAO cache has %d entries, but no hits", stats.NumVAOStates)
+	}
+}
+
+func TestGLAttachmentHints(t *testing.T) {
+	initGL(t)
+
+	// View 0 covers back buffer and view 1 part of it, so both whole and
+	// sub frame buffer invalidation are used.
+	SetViewClear(0, ClearColor, 0x303030ff, 1, 0)
+	SetViewRect(0, 0, 0, 320, 240)
+	SetViewAttachmentHints(0, AttachmentColor|AttachmentDepth|AttachmentStencil, AttachmentDepth|AttachmentStencil)
+	SetViewRect(1, 0, 0, 160, 120)
+	SetViewAttachmentHints(1, 0, AttachmentDepth)
+
+	var stats FrameStats
+	for f := 0; f < 3; f++ {
+		Submit(0)
+		Submit(1)
+		Frame()
+		stats = Stats()
+	}
+	t.Logf("invalidate calls %d", stats.GLCalls[GLCallInvalidate])
+
+	// Don't care color of view 0 is cleared, so it's masked out, which
+	// leaves depth and stencil at view start, and discards of both views.
+	if n := stats.GLCalls[GLCallInvalidate]; n != 3 {
+		t.Errorf("%d invalidate calls, want 3", n)
+	}
+}
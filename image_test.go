@@ -0,0 +1,306 @@
+package bgfx
+
+import (
+	"bytes"
+	"math"
+	"runtime"
+	"testing"
+)
+
+// testImage generates a procedural BGRA8 image with smooth gradients,
+// soft noise and a hard alpha edge, similar to runtime generated
+// terrain and lightmap textures.
+func testImage(width, height int) []byte {
+	img := make([]byte, width*height*4)
+	seed := uint32(1)
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			seed = seed*1664525 + 1013904223
+			noise := float64(seed>>24)/255.0*16.0 - 8.0
+			fx := float64(x) / float64(width)
+			fy := float64(y) / float64(height)
+			h := 0.5 + 0.25*math.Sin(fx*9.0) + 0.25*math.Cos(fy*7.0)
+			i := (y*width + x) * 4
+			img[i+0] = clampByte(255.0*fx*h + noise)
+			img[i+1] = clampByte(255.0*h + noise)
+			img[i+2] = clampByte(255.0*fy*(1.0-h) + noise)
+			if h > 0.5 {
+				img[i+3] = 255
+			} else {
+				img[i+3] = clampByte(512.0 * h)
+			}
+		}
+	}
+	return img
+}
+
+func clampByte(v float64) byte {
+	return byte(math.Max(0.0, math.Min(255.0, v)))
+}
+
+// psnr compares color channels of pixels that are opaque enough to
+// survive BC1 punch-through alpha, and alpha too when channels is 4.
+func psnr(a, b []byte, channels int) float64 {
+	var mse float64
+	var num int
+	for i := 0; i < len(a); i += 4 {
+		if channels == 3 && a[i+3] < 128 {
+			continue
+		}
+		for c := 0; c < channels; c++ {
+			d := float64(a[i+c]) - float64(b[i+c])
+			mse += d * d
+		}
+		num += channels
+	}
+	mse /= float64(num)
+	if mse == 0 {
+		return math.Inf(1)
+	}
+	return 10.0 * math.Log10(255.0*255.0/mse)
+}
+
+var imageEncodeTests = []struct {
+	format   TextureFormat
+	size     int
+	channels int
+	minPSNR  float64
+}{
+	{TextureFormatBC1, 8, 3, 35},
+	{TextureFormatBC3, 16, 4, 35},
+	{TextureFormatETC1, 8, 3, 35},
+}
+
+func roundTrip(width, height int, format TextureFormat, size, channels int) ([]byte, float64) {
+	src := testImage(width, height)
+	enc := make([]byte, (width+3)/4*((height+3)/4)*size)
+	if !ImageEncodeFromBGRA8(enc, src, width, height, width*4, format) {
+		return nil, 0
+	}
+	dec := make([]byte, len(src))
+	ImageDecodeToBGRA8(dec, enc, width, height, width*4, format)
+	return enc, psnr(src, dec, channels)
+}
+
+func TestImageEncode(t *testing.T) {
+	for _, tt := range imageEncodeTests {
+		enc, db := roundTrip(256, 256, tt.format, tt.size, tt.channels)
+		if enc == nil {
+			t.Errorf("format %d: encoding not supported", tt.format)
+			continue
+		}
+		if db < tt.minPSNR {
+			t.Errorf("format %d: PSNR %.2f dB < %.2f dB", tt.format, db, tt.minPSNR)
+		}
+	}
+
+	dst := make([]byte, 64)
+	if ImageEncodeFromBGRA8(dst, testImage(4, 4), 4, 4, 16, TextureFormatBC7) {
+		t.Errorf("BC7 encoding should not be supported")
+	}
+}
+
+func TestImageBufferSize(t *testing.T) {
+	mustPanic := func(name string, fn func()) {
+		defer func() {
+			if recover() == nil {
+				t.Errorf("%s: expected panic", name)
+			}
+		}()
+		fn()
+	}
+	src := testImage(8, 8)
+	enc := make([]byte, 32)
+	dec := make([]byte, len(src))
+	mustPanic("encode empty dst", func() { ImageEncodeFromBGRA8(nil, src, 8, 8, 32, TextureFormatBC1) })
+	mustPanic("encode short dst", func() { ImageEncodeFromBGRA8(enc[:31], src, 8, 8, 32, TextureFormatBC1) })
+	mustPanic("encode short src", func() { ImageEncodeFromBGRA8(enc, src[:100], 8, 8, 32, TextureFormatBC1) })
+	mustPanic("encode short pitch", func() { ImageEncodeFromBGRA8(enc, src, 8, 8, 16, TextureFormatBC1) })
+	mustPanic("decode short dst", func() { ImageDecodeToBGRA8(dec[:len(dec)-1], enc, 8, 8, 32, TextureFormatBC1) })
+	mustPanic("decode short src", func() { ImageDecodeToBGRA8(dec, enc[:31], 8, 8, 32, TextureFormatBC1) })
+	mustPanic("decode empty", func() { ImageDecodeToBGRA8(nil, nil, 0, 0, 0, TextureFormatBC1) })
+
+	// Exact sizes, including partial blocks on the edge.
+	if !ImageEncodeFromBGRA8(make([]byte, 2*2*16), testImage(5, 6), 5, 6, 20, TextureFormatBC3) {
+		t.Error("BC3 encoding failed")
+	}
+	ImageDecodeToBGRA8(dec, enc, 8, 8, 32, TextureFormatBC1)
+}
+
+// TestTextureCompress creates textures with compress flags, which are
+// encoded on job system before frame is handed to render thread.
+func TestTextureCompress(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	var textures []Texture
+	for _, flags := range []TextureFlags{TextureCompressBC1, TextureCompressBC3, TextureCompressETC1} {
+		for i := 0; i < 4; i++ {
+			textures = append(textures, CreateTexture2D(64, 64, 1, TextureFormatBGRA8, flags, testImage(64, 64)))
+		}
+	}
+	Frame()
+	for _, tex := range textures {
+		DestroyTexture(tex)
+	}
+	Frame()
+}
+
+// boxMip is reference 2x2 box filter, with edge texels repeated for odd
+// sizes.
+func boxMip(src []byte, width, height int) ([]byte, int, int) {
+	dw, dh := width/2, height/2
+	if dw < 1 {
+		dw = 1
+	}
+	if dh < 1 {
+		dh = 1
+	}
+	clamp := func(v, max int) int {
+		if v > max {
+			return max
+		}
+		return v
+	}
+	dst := make([]byte, dw*dh*4)
+	for y := 0; y < dh; y++ {
+		y0, y1 := clamp(y*2, height-1), clamp(y*2+1, height-1)
+		for x := 0; x < dw; x++ {
+			x0, x1 := clamp(x*2, width-1), clamp(x*2+1, width-1)
+			for c := 0; c < 4; c++ {
+				sum := int(src[(y0*width+x0)*4+c]) + int(src[(y0*width+x1)*4+c]) +
+					int(src[(y1*width+x0)*4+c]) + int(src[(y1*width+x1)*4+c])
+				dst[(y*dw+x)*4+c] = byte((sum + 2) / 4)
+			}
+		}
+	}
+	return dst, dw, dh
+}
+
+func TestImageGenerateMips(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+
+	const width, height = 37, 21
+	src := testImage(width, height)
+	mips := ImageGenerateMips(src, width, height, width*4, MipsFilterBox, 0)
+	if n := ImageNumMips(width, height); n != 6 {
+		t.Fatalf("ImageNumMips = %d, want 6", n)
+	}
+	if len(mips) != int(CalcTextureSize(width, height, 1, 6, TextureFormatBGRA8).StorageSize) {
+		t.Fatalf("mip chain size %d", len(mips))
+	}
+
+	level, w, h := src, width, height
+	offset := 0
+	for lod := 0; lod < ImageNumMips(width, height); lod++ {
+		got := mips[offset : offset+w*h*4]
+		for i := range got {
+			diff := int(got[i]) - int(level[i])
+			if diff < -1 || diff > 1 {
+				t.Fatalf("lod %d (%dx%d) byte %d: got %d, box filter %d", lod, w, h, i, got[i], level[i])
+			}
+		}
+		offset += w * h * 4
+		// Compare against reference built from generated level, so
+		// rounding differences don't accumulate down the chain.
+		level, w, h = boxMip(got, w, h)
+	}
+
+	// Kaiser and sRGB paths must produce full chain without touching
+	// top level.
+	for _, flags := range []MipsFlags{MipsFilterKaiser, MipsSRGB, MipsFilterKaiser | MipsSRGB | MipsAlphaCoverage} {
+		mips := ImageGenerateMips(src, width, height, width*4, flags, 0.5)
+		if !bytes.Equal(mips[:len(src)], src) {
+			t.Errorf("flags %#x: top level differs from source", flags)
+		}
+	}
+
+	// Texture size is 16-bit, wider chain would overrun destination.
+	func() {
+		defer func() {
+			if recover() != errImageSize {
+				t.Error("width 65536: expected errImageSize panic")
+			}
+		}()
+		ImageGenerateMips(make([]byte, 0x10000*4), 0x10000, 1, 0x10000*4, MipsFilterBox, 0)
+	}()
+}
+
+func benchmarkImageGenerateMips(b *testing.B, flags MipsFlags) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+
+	const width, height = 1024, 768
+	src := testImage(width, height)
+	b.SetBytes(int64(len(src)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		ImageGenerateMips(src, width, height, width*4, flags, 0)
+	}
+}
+
+func BenchmarkImageGenerateMipsBox(b *testing.B) {
+	benchmarkImageGenerateMips(b, MipsFilterBox)
+}
+
+func BenchmarkImageGenerateMipsKaiser(b *testing.B) {
+	benchmarkImageGenerateMips(b, MipsFilterKaiser)
+}
+
+// BenchmarkImageDownsample2x2Chain builds same chain as
+// BenchmarkImageGenerateMipsBox by looping ImageRGBA8Downsample2x2.
+func BenchmarkImageDownsample2x2Chain(b *testing.B) {
+	const width, height = 1024, 768
+	src := testImage(width, height)
+	dst := make([]byte, len(src))
+	b.SetBytes(int64(len(src)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		level := src
+		for w, h := width, height; w > 1 && h > 1; w, h = w/2, h/2 {
+			ImageRGBA8Downsample2x2(dst, level, w, h, w*4)
+			level = dst
+		}
+	}
+}
+
+func benchmarkImageEncode(b *testing.B, format TextureFormat) {
+	const width, height = 512, 512
+	for _, tt := range imageEncodeTests {
+		if tt.format != format {
+			continue
+		}
+		_, db := roundTrip(width, height, format, tt.size, tt.channels)
+		src := testImage(width, height)
+		enc := make([]byte, width/4*height/4*tt.size)
+		b.SetBytes(int64(len(src)))
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			ImageEncodeFromBGRA8(enc, src, width, height, width*4, format)
+		}
+		b.ReportMetric(db, "dB")
+	}
+}
+
+func BenchmarkImageEncodeBC1(b *testing.B) {
+	benchmarkImageEncode(b, TextureFormatBC1)
+}
+
+func BenchmarkImageEncodeBC3(b *testing.B) {
+	benchmarkImageEncode(b, TextureFormatBC3)
+}
+
+func BenchmarkImageEncodeETC1(b *testing.B) {
+	benchmarkImageEncode(b, TextureFormatETC1)
+}
@@ -147,6 +147,24 @@ typedef enum bgfx_uniform_type
 
 } bgfx_uniform_type_t;
 
+typedef enum bgfx_gl_call
+{
+    BGFX_GL_CALL_BIND_BUFFER,
+    BGFX_GL_CALL_BIND_TEXTURE,
+    BGFX_GL_CALL_ACTIVE_TEXTURE,
+    BGFX_GL_CALL_USE_PROGRAM,
+    BGFX_GL_CALL_BIND_FRAMEBUFFER,
+    BGFX_GL_CALL_BIND_VERTEX_ARRAY,
+    BGFX_GL_CALL_BIND_SAMPLER,
+    BGFX_GL_CALL_ENABLE,
+    BGFX_GL_CALL_UNIFORM,
+    BGFX_GL_CALL_DRAW,
+    BGFX_GL_CALL_INVALIDATE,
+
+    BGFX_GL_CALL_COUNT
+
+} bgfx_gl_call_t;
+
 #define BGFX_HANDLE_T(_name) \
     typedef struct _name { uint16_t idx; } _name##_t;
 
@@ -193,6 +211,99 @@ typedef struct bgfx_vertex_decl
 
 } bgfx_vertex_decl_t;
 
+/**
+ * Precompiled vertex stream conversion.
+ */
+typedef struct bgfx_vertex_convert_op
+{
+    uint16_t src;
+    uint16_t dest;
+    uint8_t  op;
+    uint8_t  size;
+    uint8_t  unpack;
+    uint8_t  pack;
+
+} bgfx_vertex_convert_op_t;
+
+typedef struct bgfx_vertex_convert_plan
+{
+    uint16_t src_stride;
+    uint16_t dest_stride;
+    uint8_t  num_ops;
+    bool     copy;
+    bgfx_vertex_convert_op_t ops[BGFX_ATTRIB_COUNT];
+
+} bgfx_vertex_convert_plan_t;
+
+/**
+ * Post-transform vertex cache statistics.
+ */
+typedef struct bgfx_vertex_cache_stats
+{
+    uint32_t num_transformed;
+    float    acmr;
+    float    atvr;
+
+} bgfx_vertex_cache_stats_t;
+
+/**
+ * CPU occlusion buffer.
+ */
+typedef struct bgfx_occlusion_buffer bgfx_occlusion_buffer_t;
+
+/**
+ * Occlusion buffer statistics.
+ */
+typedef struct bgfx_occlusion_stats
+{
+    uint32_t num_occluders;
+    uint32_t num_triangles;
+    uint32_t num_tested;
+    uint32_t num_visible;
+
+} bgfx_occlusion_stats_t;
+
+/**
+ * Mesh or mesh group bounding volumes.
+ */
+typedef struct bgfx_mesh_bounds
+{
+    float sphere[4];
+    float min[3];
+    float max[3];
+
+} bgfx_mesh_bounds_t;
+
+/**
+ * Range of mesh triangles.
+ */
+typedef struct bgfx_mesh_group
+{
+    uint32_t startIndex;
+    uint32_t numIndices;
+    uint32_t startVertex;
+    uint32_t numVertices;
+    bgfx_mesh_bounds_t bounds;
+
+} bgfx_mesh_group_t;
+
+/**
+ * Mesh container contents.
+ */
+typedef struct bgfx_mesh_info
+{
+    bgfx_vertex_decl_t decl;
+    const void* vertices;
+    uint32_t numVertices;
+    const void* indices;
+    uint32_t numIndices;
+    bool index32;
+    const bgfx_mesh_group_t* groups;
+    uint32_t numGroups;
+    bgfx_mesh_bounds_t bounds;
+
+} bgfx_mesh_info_t;
+
 /**
  */
 typedef struct bgfx_transient_index_buffer
@@ -201,6 +312,7 @@ typedef struct bgfx_transient_index_buffer
     uint32_t size;
     bgfx_index_buffer_handle_t handle;
     uint32_t startIndex;
+    bool index32;
 
 } bgfx_transient_index_buffer_t;
 
@@ -275,6 +387,117 @@ typedef struct bgfx_caps
 
 } bgfx_caps_t;
 
+/**
+ *  Per frame resource limits and handle counts. Fields left at zero take
+ *  default from matching BGFX_CONFIG_* define.
+ *
+ *  NOTE:
+ *    Handle counts are up to 65535, program handles are also limited by
+ *    BGFX_CONFIG_MAX_PROGRAMS.
+ */
+typedef struct bgfx_limits
+{
+    uint16_t maxDrawCalls;          /* < Draw calls.                      */
+    uint32_t maxMatrixCache;        /* < Transform matrices.              */
+    uint32_t maxRectCache;          /* < Scissor rectangles, up to 65535. */
+    uint32_t maxConstantBufferSize; /* < Uniform data in bytes.           */
+    uint32_t transientVbSize;       /* < Transient vertex buffer size.    */
+    uint32_t transientIbSize;       /* < Transient index buffer size.     */
+
+    uint16_t maxIndexBuffers;         /* < Index buffer handles.          */
+    uint16_t maxVertexBuffers;        /* < Vertex buffer handles.         */
+    uint16_t maxDynamicIndexBuffers;  /* < Dynamic index buffer handles.  */
+    uint16_t maxDynamicVertexBuffers; /* < Dynamic vertex buffer handles. */
+    uint16_t maxVertexDecls;          /* < Vertex declaration handles.    */
+    uint16_t maxShaders;              /* < Shader handles.                */
+    uint16_t maxPrograms;             /* < Program handles.               */
+    uint16_t maxTextures;             /* < Texture handles.               */
+    uint16_t maxFrameBuffers;         /* < Frame buffer handles.          */
+    uint16_t maxUniforms;             /* < Uniform handles.               */
+
+} bgfx_limits_t;
+
+/**
+ *  Frame timing and renderer statistics. All times are in CPU timer ticks.
+ *
+ *  NOTE:
+ *    State cache counters are counted since init, and are kept only by
+ *    OpenGL renderer, as are OpenGL call counts of last frame.
+ */
+typedef struct bgfx_stats
+{
+    int64_t cpuTimerFreq;    /* < CPU timer frequency.                               */
+    int64_t cpuTimeSubmit;   /* < API thread time spent building last frame.          */
+    int64_t cpuTimeRender;   /* < Render thread time spent executing last frame.      */
+    int64_t cpuTimeFlip;     /* < Render thread time spent presenting last frame.     */
+    int64_t waitRender;      /* < API thread time spent waiting for render thread.    */
+    int64_t waitSubmit;      /* < Render thread time spent waiting for API thread.    */
+    int64_t waitPacing;      /* < Time spent in last bgfx_wait_frame_start call.      */
+    int64_t predictedRender; /* < Predicted render thread time per frame.             */
+    int64_t latency;         /* < Submit-to-flip latency of last presented frame.     */
+    int64_t latencyMin;      /* < Minimum submit-to-flip latency of recent frames.    */
+    int64_t latencyMax;      /* < Maximum submit-to-flip latency of recent frames.    */
+
+    uint32_t numDraws;         /* < Draw and compute calls submitted in last frame.   */
+    uint32_t numDropped;       /* < Calls dropped in last frame, over maxDrawCalls.   */
+
+    uint32_t numVaoStates;     /* < Cached vertex array objects.                      */
+    uint32_t vaoHits;          /* < Vertex array cache hits.                          */
+    uint32_t vaoMisses;        /* < Vertex array cache misses.                        */
+    uint32_t vaoEvictions;     /* < Vertex array objects evicted from full cache.     */
+    uint32_t numSamplerStates; /* < Cached sampler objects.                           */
+    uint32_t samplerHits;      /* < Sampler cache hits.                               */
+    uint32_t samplerMisses;    /* < Sampler cache misses.                             */
+    uint32_t samplerEvictions; /* < Sampler objects evicted from full cache.          */
+
+    uint32_t glCalls[BGFX_GL_CALL_COUNT];         /* < OpenGL calls issued, per category.      */
+    uint32_t glCallsFiltered[BGFX_GL_CALL_COUNT]; /* < Redundant OpenGL calls filtered.        */
+
+} bgfx_stats_t;
+
+/**
+ *  Replayed frame statistics. All times are in CPU timer ticks.
+ */
+typedef struct bgfx_replay_stats
+{
+    uint32_t frame;        /* < Replayed frame number.                             */
+    uint32_t numCalls;     /* < Number of API calls issued.                        */
+    uint32_t numSubmits;   /* < Number of submit and dispatch calls.               */
+    int64_t cpuTimeIssue;  /* < Time spent issuing API calls, excluding trace IO.  */
+    int64_t cpuTimeFrame;  /* < Time spent in bgfx_frame call.                     */
+
+} bgfx_replay_stats_t;
+
+/**
+ *  Dynamic buffer backing pool statistics.
+ */
+typedef struct bgfx_buffer_pool_stats
+{
+    uint64_t size;          /* < Total size of backing buffers in bytes.          */
+    uint64_t used;          /* < Bytes used by live dynamic buffers.              */
+    uint32_t largestFree;   /* < Largest free range in bytes.                     */
+    uint32_t numBuffers;    /* < Number of backing buffers.                       */
+    uint32_t numAllocs;     /* < Number of live dynamic buffers.                  */
+    uint32_t numFreeRanges; /* < Number of free ranges.                           */
+    uint32_t numReleased;   /* < Empty backing buffers released so far.           */
+    uint32_t numRelocated;  /* < Dynamic buffers relocated by compaction so far.  */
+
+} bgfx_buffer_pool_stats_t;
+
+/**
+ *  Transient frame buffer pool statistics.
+ */
+typedef struct bgfx_transient_frame_buffer_stats
+{
+    uint64_t requestedSize;   /* < Size of frame buffers requested in last frame.    */
+    uint64_t allocatedSize;   /* < Size of pooled frame buffers.                     */
+    uint32_t numRequests;     /* < Number of frame buffers requested in last frame.  */
+    uint32_t numFrameBuffers; /* < Number of pooled frame buffers.                   */
+    uint32_t numCreated;      /* < Pooled frame buffers created so far.              */
+    uint32_t numReleased;     /* < Pooled frame buffers released so far.             */
+
+} bgfx_transient_frame_buffer_stats_t;
+
 /**
  */
 typedef enum bgfx_fatal
@@ -458,6 +681,34 @@ BGFX_C_API void bgfx_vertex_pack(const float _input[4], bool _inputNormalized, b
  */
 BGFX_C_API void bgfx_vertex_unpack(float _output[4], bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _index);
 
+/**
+ *  Pack array of vectors into one attribute of vertex stream.
+ *
+ *  @param _input Input vectors, tightly packed.
+ *  @param _inputNum Number of elements per input vector 1, 2, 3 or 4.
+ *    Missing elements are packed as 0.0f.
+ *  @param _inputNormalized Same as in `bgfx_vertex_pack`.
+ *  @param _attr Attribute semantics.
+ *  @param _decl Vertex stream declaration.
+ *  @param _data Destination vertex stream.
+ *  @param _num Number of vertices to pack.
+ *  @param _index Index of first vertex in vertex stream.
+ */
+BGFX_C_API void bgfx_vertex_pack_array(const float* _input, uint8_t _inputNum, bool _inputNormalized, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, void* _data, uint32_t _num, uint32_t _index);
+
+/**
+ *  Unpack one attribute of vertex stream into array of vectors.
+ *
+ *  @param _output Output vectors, tightly packed.
+ *  @param _outputNum Number of elements per output vector 1, 2, 3 or 4.
+ *  @param _attr Attribute semantics.
+ *  @param _decl Vertex stream declaration.
+ *  @param _data Source vertex stream.
+ *  @param _num Number of vertices to unpack.
+ *  @param _index Index of first vertex in vertex stream.
+ */
+BGFX_C_API void bgfx_vertex_unpack_array(float* _output, uint8_t _outputNum, bgfx_attrib_t _attr, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, uint32_t _index);
+
 /**
  *  Converts vertex stream data from one vertex stream format to another.
  *
@@ -469,6 +720,26 @@ BGFX_C_API void bgfx_vertex_unpack(float _output[4], bgfx_attrib_t _attr, const
  */
 BGFX_C_API void bgfx_vertex_convert(const bgfx_vertex_decl_t* _destDecl, void* _destData, const bgfx_vertex_decl_t* _srcDecl, const void* _srcData, uint32_t _num);
 
+/**
+ *  Compile vertex stream conversion plan from one vertex stream format
+ *  to another.
+ *
+ *  @param _plan Conversion plan.
+ *  @param _destDecl Destination vertex stream declaration.
+ *  @param _srcDecl Source vertex stream declaration.
+ */
+BGFX_C_API void bgfx_vertex_convert_plan(bgfx_vertex_convert_plan_t* _plan, const bgfx_vertex_decl_t* _destDecl, const bgfx_vertex_decl_t* _srcDecl);
+
+/**
+ *  Converts vertex stream data using precompiled conversion plan.
+ *
+ *  @param _plan Conversion plan.
+ *  @param _destData Destination vertex stream.
+ *  @param _srcData Source vertex stream data.
+ *  @param _num Number of vertices to convert from source to destination.
+ */
+BGFX_C_API void bgfx_vertex_convert_planned(const bgfx_vertex_convert_plan_t* _plan, void* _destData, const void* _srcData, uint32_t _num);
+
 /**
  *  Weld vertices.
  *
@@ -482,6 +753,204 @@ BGFX_C_API void bgfx_vertex_convert(const bgfx_vertex_decl_t* _destDecl, void* _
  */
 BGFX_C_API uint16_t bgfx_weld_vertices(uint16_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint16_t _num, float _epsilon);
 
+/**
+ *  Weld vertices.
+ *
+ *  @param _output Welded vertices remapping table. The size of buffer
+ *    must be the same as number of vertices.
+ *  @param _decl Vertex stream declaration.
+ *  @param _data Vertex stream.
+ *  @param _num Number of vertices in vertex stream.
+ *  @param _epsilon Error tolerance for vertex attribute comparison.
+ *  @param _attribMask Attributes compared in addition to position, bit
+ *    `1<<bgfx_attrib_t` is set for each attribute.
+ *  @returns Number of unique vertices after vertex welding.
+ */
+BGFX_C_API uint32_t bgfx_weld_vertices32(uint32_t* _output, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _num, float _epsilon, uint32_t _attribMask);
+
+/**
+ *  Reorder triangles for post-transform vertex cache.
+ *
+ *  @param _indices Triangle list indices, reordered in place.
+ *  @param _numIndices Number of indices.
+ *  @param _numVertices Number of vertices referenced by indices.
+ */
+BGFX_C_API void bgfx_optimize_vertex_cache(uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices);
+
+/**
+ *  Reorder triangle clusters to reduce overdraw.
+ *
+ *  @param _indices Triangle list indices, reordered in place.
+ *  @param _numIndices Number of indices.
+ *  @param _decl Vertex stream declaration.
+ *  @param _data Vertex stream.
+ *  @param _numVertices Number of vertices in vertex stream.
+ *  @param _cacheSize Simulated FIFO cache size used to find cluster
+ *    boundaries.
+ */
+BGFX_C_API void bgfx_optimize_overdraw(uint32_t* _indices, uint32_t _numIndices, const bgfx_vertex_decl_t* _decl, const void* _data, uint32_t _numVertices, uint32_t _cacheSize);
+
+/**
+ *  Reorder vertices in order of first use by index buffer.
+ *
+ *  @param _destData Destination vertex stream.
+ *  @param _remap Vertex remapping table. The size of buffer must be the
+ *    same as number of vertices.
+ *  @param _decl Vertex stream declaration.
+ *  @param _srcData Source vertex stream.
+ *  @param _numVertices Number of vertices in source vertex stream.
+ *  @param _indices Triangle list indices, remapped in place.
+ *  @param _numIndices Number of indices.
+ *  @returns Number of vertices written to destination vertex stream.
+ */
+BGFX_C_API uint32_t bgfx_optimize_vertex_fetch(void* _destData, uint32_t* _remap, const bgfx_vertex_decl_t* _decl, const void* _srcData, uint32_t _numVertices, uint32_t* _indices, uint32_t _numIndices);
+
+/**
+ *  Simulate FIFO post-transform vertex cache.
+ *
+ *  @param _stats Vertex cache statistics.
+ *  @param _indices Triangle list indices.
+ *  @param _numIndices Number of indices.
+ *  @param _numVertices Number of vertices referenced by indices.
+ *  @param _cacheSize Simulated FIFO cache size.
+ */
+BGFX_C_API void bgfx_analyze_vertex_cache(bgfx_vertex_cache_stats_t* _stats, const uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices, uint32_t _cacheSize);
+
+/**
+ *  Test bounding spheres against view frustum.
+ *
+ *  @param _visible Visibility bitmask, bit is set when sphere is at
+ *    least partially inside of frustum. The size of buffer must be at
+ *    least (_num+31)/32 words.
+ *  @param _viewProj View-projection matrix.
+ *  @param _x Sphere center x coordinates.
+ *  @param _y Sphere center y coordinates.
+ *  @param _z Sphere center z coordinates.
+ *  @param _radius Sphere radii.
+ *  @param _num Number of spheres.
+ *  @param _oglNdc Projection matrix maps depth to [-1, 1] range.
+ */
+BGFX_C_API void bgfx_cull_spheres(uint32_t* _visible, const void* _viewProj, const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _num, bool _oglNdc);
+
+/**
+ *  Test axis aligned bounding boxes against view frustum.
+ *
+ *  @param _visible Visibility bitmask, bit is set when box is at least
+ *    partially inside of frustum. The size of buffer must be at least
+ *    (_num+31)/32 words.
+ *  @param _viewProj View-projection matrix.
+ *  @param _minX Box minimum x coordinates.
+ *  @param _minY Box minimum y coordinates.
+ *  @param _minZ Box minimum z coordinates.
+ *  @param _maxX Box maximum x coordinates.
+ *  @param _maxY Box maximum y coordinates.
+ *  @param _maxZ Box maximum z coordinates.
+ *  @param _num Number of boxes.
+ *  @param _oglNdc Projection matrix maps depth to [-1, 1] range.
+ */
+BGFX_C_API void bgfx_cull_aabbs(uint32_t* _visible, const void* _viewProj, const float* _minX, const float* _minY, const float* _minZ, const float* _maxX, const float* _maxY, const float* _maxZ, uint32_t _num, bool _oglNdc);
+
+/**
+ *  Create CPU occlusion buffer. Width and height are rounded up to
+ *  multiple of 8, and clamped to 65528.
+ */
+BGFX_C_API bgfx_occlusion_buffer_t* bgfx_create_occlusion_buffer(uint16_t _width, uint16_t _height);
+
+/**
+ */
+BGFX_C_API void bgfx_destroy_occlusion_buffer(bgfx_occlusion_buffer_t* _ob);
+
+/**
+ *  Start collecting occluders for view.
+ *
+ *  @param _ob Occlusion buffer.
+ *  @param _view View matrix, same as passed to bgfx_set_view_transform.
+ *  @param _proj Projection matrix, same as passed to
+ *    bgfx_set_view_transform.
+ *  @param _oglNdc Projection matrix maps depth to [-1, 1] range.
+ */
+BGFX_C_API void bgfx_occlusion_begin(bgfx_occlusion_buffer_t* _ob, const void* _view, const void* _proj, bool _oglNdc);
+
+/**
+ *  Add occluder mesh.
+ *
+ *  @param _ob Occlusion buffer.
+ *  @param _mtx Model matrix. When NULL vertices are in world space.
+ *  @param _vertices Vertices, each vertex starts with float x, y, z
+ *    position.
+ *  @param _stride Vertex stride.
+ *  @param _numVertices Number of vertices.
+ *  @param _indices Triangle list indices.
+ *  @param _numIndices Number of indices.
+ */
+BGFX_C_API void bgfx_occlusion_add_occluder(bgfx_occlusion_buffer_t* _ob, const void* _mtx, const void* _vertices, uint16_t _stride, uint32_t _numVertices, const uint32_t* _indices, uint32_t _numIndices);
+
+/**
+ *  Rasterize occluders added since bgfx_occlusion_begin.
+ */
+BGFX_C_API void bgfx_occlusion_rasterize(bgfx_occlusion_buffer_t* _ob);
+
+/**
+ *  Test world space axis aligned bounding boxes against view frustum
+ *  and occluders.
+ *
+ *  @param _ob Occlusion buffer.
+ *  @param _visible Visibility bitmask, bit is set when box might be
+ *    visible. The size of buffer must be at least (_num+31)/32 words.
+ *  @param _minX Box minimum x coordinates.
+ *  @param _minY Box minimum y coordinates.
+ *  @param _minZ Box minimum z coordinates.
+ *  @param _maxX Box maximum x coordinates.
+ *  @param _maxY Box maximum y coordinates.
+ *  @param _maxZ Box maximum z coordinates.
+ *  @param _num Number of boxes.
+ */
+BGFX_C_API void bgfx_occlusion_test_aabbs(bgfx_occlusion_buffer_t* _ob, uint32_t* _visible, const float* _minX, const float* _minY, const float* _minZ, const float* _maxX, const float* _maxY, const float* _maxZ, uint32_t _num);
+
+/**
+ */
+BGFX_C_API void bgfx_get_occlusion_stats(const bgfx_occlusion_buffer_t* _ob, bgfx_occlusion_stats_t* _stats);
+
+/**
+ *  Read back depth buffer, rows from top to bottom.
+ */
+BGFX_C_API void bgfx_read_occlusion_depth(const bgfx_occlusion_buffer_t* _ob, float* _depth);
+
+/**
+ *  Write mesh container.
+ *
+ *  @param _dst Destination buffer, or NULL to query container size.
+ *  @param _size Size of destination buffer.
+ *  @param _decl Vertex stream declaration.
+ *  @param _vertices Vertex stream.
+ *  @param _numVertices Number of vertices in vertex stream.
+ *  @param _indices Triangle list indices.
+ *  @param _numIndices Number of indices.
+ *  @param _index32 Indices are 32-bit, otherwise they are 16-bit.
+ *  @param _groups Mesh groups, or NULL for single group.
+ *  @param _numGroups Number of mesh groups.
+ *  @returns Size of mesh container.
+ *
+ *  NOTE:
+ *    Container is written only when destination buffer is large enough.
+ */
+BGFX_C_API uint32_t bgfx_mesh_write(void* _dst, uint32_t _size, const bgfx_vertex_decl_t* _decl, const void* _vertices, uint32_t _numVertices, const void* _indices, uint32_t _numIndices, bool _index32, const bgfx_mesh_group_t* _groups, uint32_t _numGroups);
+
+/**
+ *  Parse mesh container.
+ *
+ *  @param _info Mesh container contents.
+ *  @param _data Mesh container, must be at least 4-byte aligned.
+ *  @param _size Size of mesh container.
+ *  @returns True if container is valid.
+ *
+ *  NOTE:
+ *    Vertices, indices and groups point inside container, so they can be
+ *    passed to bgfx_make_ref without copying, while container stays valid
+ *    for at least _numFrames (see bgfx_init) bgfx_frame calls.
+ */
+BGFX_C_API bool bgfx_mesh_parse(bgfx_mesh_info_t* _info, const void* _data, uint32_t _size);
+
 /**
  *  Swizzle RGBA8 image to BGRA8.
  *
@@ -506,6 +975,62 @@ BGFX_C_API void bgfx_image_swizzle_bgra8(uint32_t _width, uint32_t _height, uint
  */
 BGFX_C_API void bgfx_image_rgba8_downsample_2x2(uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src, void* _dst);
 
+/**
+ *  Generate full mip chain for RGBA8 image.
+ *
+ *  @param _width Width of input image (pixels).
+ *  @param _height Height of input image (pixels).
+ *  @param _pitch Pitch of input image (bytes).
+ *  @param _src Source image.
+ *  @param _flags BGFX_MIPS_FILTER_[BOX/KAISER], BGFX_MIPS_SRGB and
+ *    BGFX_MIPS_ALPHA_COVERAGE.
+ *  @param _alphaRef Alpha test reference value used for alpha coverage.
+ *  @param _info When non-NULL is specified it returns texture
+ *    information for returned memory.
+ *  @returns Memory with all mip levels, including input image as top
+ *    level, that can be passed directly to bgfx_create_texture_2d. NULL
+ *    when width or height is above 65535.
+ */
+BGFX_C_API const bgfx_memory_t* bgfx_image_generate_mips(uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src, uint32_t _flags, float _alphaRef, bgfx_texture_info_t* _info);
+
+/**
+ *  Generate full mip chain for RGBA8 image into caller owned memory.
+ *
+ *  @param _dst Destination. Must hold all mip levels of RGBA8 texture,
+ *    see bgfx_calc_texture_size.
+ *
+ *  Other parameters are same as bgfx_image_generate_mips.
+ */
+BGFX_C_API void bgfx_image_generate_mip_chain(void* _dst, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src, uint32_t _flags, float _alphaRef);
+
+/**
+ *  Encode BGRA8 image into block compressed texture format.
+ *
+ *  @param _dst Destination image. Must be large enough to hold all
+ *    4x4 blocks covering input image.
+ *  @param _src Source BGRA8 image.
+ *  @param _width Width of input image (pixels).
+ *  @param _height Height of input image (pixels).
+ *  @param _pitch Pitch of input image (bytes).
+ *  @param _format Destination format. Supported formats are
+ *    BGFX_TEXTURE_FORMAT_BC1, BGFX_TEXTURE_FORMAT_BC3 and
+ *    BGFX_TEXTURE_FORMAT_ETC1.
+ *  @returns True if image is encoded.
+ */
+BGFX_C_API bool bgfx_image_encode_from_bgra8(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _pitch, bgfx_texture_format_t _format);
+
+/**
+ *  Decode block compressed image to BGRA8.
+ *
+ *  @param _dst Destination BGRA8 image.
+ *  @param _src Source image.
+ *  @param _width Width of output image (pixels).
+ *  @param _height Height of output image (pixels).
+ *  @param _pitch Pitch of output image (bytes).
+ *  @param _format Source format.
+ */
+BGFX_C_API void bgfx_image_decode_to_bgra8(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _pitch, bgfx_texture_format_t _format);
+
 /**
  *  Returns supported backend API renderers.
  */
@@ -528,8 +1053,13 @@ BGFX_C_API const char* bgfx_get_renderer_name(bgfx_renderer_type_t _type);
  *  @param _reallocator Custom allocator. When custom allocator is not
  *    specified, library uses default CRT allocator. The library assumes
  *    custom allocator is thread safe.
+ *
+ *  @param _numFrames Number of frames in flight between API and render
+ *    thread, clamped to 2-4.
+ *
+ *  @param _limits Per frame resource limits, or NULL for defaults.
  */
-BGFX_C_API void bgfx_init(bgfx_renderer_type_t _type, bgfx_callback_interface_t* _callback, bgfx_reallocator_interface_t* _allocator);
+BGFX_C_API void bgfx_init(bgfx_renderer_type_t _type, bgfx_callback_interface_t* _callback, bgfx_reallocator_interface_t* _allocator, uint8_t _numFrames, const bgfx_limits_t* _limits);
 
 /**
  *  Shutdown bgfx library.
@@ -568,6 +1098,74 @@ BGFX_C_API bgfx_renderer_type_t bgfx_get_renderer_type();
  */
 BGFX_C_API bgfx_caps_t* bgfx_get_caps();
 
+/**
+ *  Returns per frame resource limits set at init.
+ */
+BGFX_C_API const bgfx_limits_t* bgfx_get_limits();
+
+/**
+ *  Returns frame timing statistics.
+ *
+ *  NOTE:
+ *    Library must be initialized.
+ */
+BGFX_C_API const bgfx_stats_t* bgfx_get_stats();
+
+/**
+ *  Returns dynamic index and vertex buffer backing pool statistics.
+ *
+ *  NOTE:
+ *    Backing buffers that stay empty for BGFX_CONFIG_DYNAMIC_BUFFER_TRIM_FRAMES
+ *    frames are released. Dynamic buffer updated as a whole is moved out of
+ *    sparse backing buffer.
+ */
+BGFX_C_API void bgfx_get_buffer_pool_stats(bgfx_buffer_pool_stats_t* _indexPool, bgfx_buffer_pool_stats_t* _vertexPool);
+
+/**
+ *  Low-latency frame pacing. Blocks until the latest time the next frame
+ *  can start and still be submitted before render thread runs out of work.
+ *  Call after bgfx_frame, right before sampling input.
+ */
+BGFX_C_API void bgfx_wait_frame_start();
+
+/**
+ *  Start recording API calls into trace file.
+ *
+ *  NOTE:
+ *    Resources created before recording started are not part of trace.
+ */
+BGFX_C_API bool bgfx_record_begin(const char* _filePath);
+
+/**
+ *  Stop recording and close trace file.
+ */
+BGFX_C_API void bgfx_record_end();
+
+/**
+ *  Open trace file for replay.
+ */
+BGFX_C_API bool bgfx_replay_begin(const char* _filePath);
+
+/**
+ *  Replay single recorded frame. Returns false at the end of trace.
+ *
+ *  NOTE:
+ *    Trace IO is not included in statistics.
+ */
+BGFX_C_API bool bgfx_replay_frame(bgfx_replay_stats_t* _stats);
+
+/**
+ *  Stop replaying, destroy resources trace didn't destroy and close trace
+ *  file.
+ */
+BGFX_C_API void bgfx_replay_end();
+
+/**
+ *  Write profiler zones captured while BGFX_DEBUG_PROFILER is set into
+ *  Chrome trace event JSON file.
+ */
+BGFX_C_API bool bgfx_profiler_save(const char* _filePath);
+
 /**
  *  Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
  */
@@ -581,7 +1179,8 @@ BGFX_C_API const bgfx_memory_t* bgfx_copy(const void* _data, uint32_t _size);
 /**
  *  Make reference to data to pass to bgfx. Unlike bgfx::alloc this call
  *  doesn't allocate memory for data. It just copies pointer to data.
- *  You must make sure data is available for at least 2 bgfx::frame calls.
+ *  You must make sure data is available for at least _numFrames (see
+ *  bgfx_init) bgfx_frame calls.
  */
 BGFX_C_API const bgfx_memory_t* bgfx_make_ref(const void* _data, uint32_t _size);
 
@@ -616,10 +1215,14 @@ BGFX_C_API void bgfx_dbg_text_printf(uint16_t _x, uint16_t _y, uint8_t _attr, co
 /**
  *  Create static index buffer.
  *
+ *  @param _mem Index buffer data.
+ *  @param _flags Buffer flags. Index buffer is 32-bit when
+ *    `BGFX_BUFFER_INDEX32` is set, otherwise it's 16-bit.
+ *
  *  NOTE:
- *    Only 16-bit index buffer is supported.
+ *    32-bit index buffer requires `BGFX_CAPS_INDEX32`.
  */
-BGFX_C_API bgfx_index_buffer_handle_t bgfx_create_index_buffer(const bgfx_memory_t* _mem);
+BGFX_C_API bgfx_index_buffer_handle_t bgfx_create_index_buffer(const bgfx_memory_t* _mem, uint8_t _flags);
 
 /**
  *  Destroy static index buffer.
@@ -646,21 +1249,25 @@ BGFX_C_API void bgfx_destroy_vertex_buffer(bgfx_vertex_buffer_handle_t _handle);
  *  Create empty dynamic index buffer.
  *
  *  @param _num Number of indices.
+ *  @param _flags Buffer flags. Index buffer is 32-bit when
+ *    `BGFX_BUFFER_INDEX32` is set, otherwise it's 16-bit.
  *
  *  NOTE:
- *    Only 16-bit index buffer is supported.
+ *    32-bit index buffer requires `BGFX_CAPS_INDEX32`.
  */
-BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer(uint32_t _num);
+BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer(uint32_t _num, uint8_t _flags);
 
 /**
  *  Create dynamic index buffer and initialized it.
  *
  *  @param _mem Index buffer data.
+ *  @param _flags Buffer flags. Index buffer is 32-bit when
+ *    `BGFX_BUFFER_INDEX32` is set, otherwise it's 16-bit.
  *
  *  NOTE:
- *    Only 16-bit index buffer is supported.
+ *    32-bit index buffer requires `BGFX_CAPS_INDEX32`.
  */
-BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer_mem(const bgfx_memory_t* _mem);
+BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer_mem(const bgfx_memory_t* _mem, uint8_t _flags);
 
 /**
  *  Update dynamic index buffer.
@@ -670,6 +1277,15 @@ BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer_m
  */
 BGFX_C_API void bgfx_update_dynamic_index_buffer(bgfx_dynamic_index_buffer_handle_t _handle, const bgfx_memory_t* _mem);
 
+/**
+ *  Update part of dynamic index buffer.
+ *
+ *  @param _handle Dynamic index buffer handle.
+ *  @param _startIndex First index to update.
+ *  @param _mem Index buffer data.
+ */
+BGFX_C_API void bgfx_update_dynamic_index_buffer_range(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _startIndex, const bgfx_memory_t* _mem);
+
 /**
  *  Destroy dynamic index buffer.
  *
@@ -698,6 +1314,15 @@ BGFX_C_API bgfx_dynamic_vertex_buffer_handle_t bgfx_create_dynamic_vertex_buffer
  */
 BGFX_C_API void bgfx_update_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle, const bgfx_memory_t* _mem);
 
+/**
+ *  Update part of dynamic vertex buffer.
+ *
+ *  @param _handle Dynamic vertex buffer handle.
+ *  @param _startVertex First vertex to update.
+ *  @param _mem Vertex buffer data.
+ */
+BGFX_C_API void bgfx_update_dynamic_vertex_buffer_range(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
+
 /**
  *  Destroy dynamic vertex buffer.
  */
@@ -707,8 +1332,9 @@ BGFX_C_API void bgfx_destroy_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_ha
  *  Returns true if internal transient index buffer has enough space.
  *
  *  @param _num Number of indices.
+ *  @param _index32 Set to `true` for 32-bit indices.
  */
-BGFX_C_API bool bgfx_check_avail_transient_index_buffer(uint32_t _num);
+BGFX_C_API bool bgfx_check_avail_transient_index_buffer(uint32_t _num, bool _index32);
 
 /**
  *  Returns true if internal transient vertex buffer has enough space.
@@ -733,8 +1359,9 @@ BGFX_C_API bool bgfx_check_avail_instance_data_buffer(uint32_t _num, uint16_t _s
  *  @param _numVertices Number of vertices.
  *  @param _decl Vertex declaration.
  *  @param _numIndices Number of indices.
+ *  @param _index32 Set to `true` for 32-bit indices.
  */
-BGFX_C_API bool bgfx_check_avail_transient_buffers(uint32_t _numVertices, const bgfx_vertex_decl_t* _decl, uint32_t _numIndices);
+BGFX_C_API bool bgfx_check_avail_transient_buffers(uint32_t _numVertices, const bgfx_vertex_decl_t* _decl, uint32_t _numIndices, bool _index32);
 
 /**
  *  Allocate transient index buffer.
@@ -743,13 +1370,14 @@ BGFX_C_API bool bgfx_check_avail_transient_buffers(uint32_t _numVertices, const
  *    for the duration of frame, and it can be reused for multiple draw
  *    calls.
  *  @param _num Number of indices to allocate.
+ *  @param _index32 Set to `true` for 32-bit indices.
  *
  *  NOTE:
  *    1. You must call setIndexBuffer after alloc in order to avoid memory
  *       leak.
- *    2. Only 16-bit index buffer is supported.
+ *    2. 32-bit indices require `BGFX_CAPS_INDEX32`.
  */
-BGFX_C_API void bgfx_alloc_transient_index_buffer(bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+BGFX_C_API void bgfx_alloc_transient_index_buffer(bgfx_transient_index_buffer_t* _tib, uint32_t _num, bool _index32);
 
 /**
  *  Allocate transient vertex buffer.
@@ -772,9 +1400,9 @@ BGFX_C_API void bgfx_alloc_transient_vertex_buffer(bgfx_transient_vertex_buffer_
  *  true.
  *
  *  NOTE:
- *    Only 16-bit index buffer is supported.
+ *    More than 65535 vertices can be addressed only with 32-bit indices.
  */
-BGFX_C_API bool bgfx_alloc_transient_buffers(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_decl_t* _decl, uint16_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint16_t _numIndices);
+BGFX_C_API bool bgfx_alloc_transient_buffers(bgfx_transient_vertex_buffer_t* _tvb, const bgfx_vertex_decl_t* _decl, uint32_t _numVertices, bgfx_transient_index_buffer_t* _tib, uint32_t _numIndices, bool _index32);
 
 /**
  *  Allocate instance data buffer.
@@ -994,6 +1622,29 @@ BGFX_C_API bgfx_frame_buffer_handle_t bgfx_create_frame_buffer_from_nwh(void* _n
  */
 BGFX_C_API void bgfx_destroy_frame_buffer(bgfx_frame_buffer_handle_t _handle);
 
+/**
+ *  Allocate transient frame buffer, valid for views _firstView to
+ *  _lastView of current frame only.
+ *
+ *  @param _width Texture width.
+ *  @param _height Texture height.
+ *  @param _format Texture format.
+ *  @param _firstView First view using frame buffer.
+ *  @param _lastView Last view using frame buffer.
+ *  @param _textureFlags Texture flags.
+ *
+ *  NOTE:
+ *    Requests with the same size, format and texture flags whose view
+ *    ranges don't overlap share the same textures. Don't destroy
+ *    transient frame buffer. Invalid view range returns invalid handle.
+ */
+BGFX_C_API bgfx_frame_buffer_handle_t bgfx_alloc_transient_frame_buffer(uint16_t _width, uint16_t _height, bgfx_texture_format_t _format, uint8_t _firstView, uint8_t _lastView, uint32_t _textureFlags);
+
+/**
+ *  Returns transient frame buffer pool statistics.
+ */
+BGFX_C_API void bgfx_get_transient_frame_buffer_stats(bgfx_transient_frame_buffer_stats_t* _stats);
+
 /**
  *  Create shader uniform parameter.
  *
@@ -1103,6 +1754,18 @@ BGFX_C_API void bgfx_set_view_clear(uint8_t _id, uint8_t _flags, uint32_t _rgba,
  */
 BGFX_C_API void bgfx_set_view_clear_mrt(uint8_t _id, uint8_t _flags, float _depth, uint8_t _stencil, uint8_t _0, uint8_t _1, uint8_t _2, uint8_t _3, uint8_t _4, uint8_t _5, uint8_t _6, uint8_t _7);
 
+/**
+ *  Set view frame buffer attachment hints. Attachments are loaded at
+ *  the start of view unless cleared, and stored at the end of view.
+ *
+ *  @param _id View id.
+ *  @param _dont_care Attachments whose previous contents are not needed
+ *    by view, they are not loaded. See: BGFX_ATTACHMENT_*.
+ *  @param _discard Attachments whose contents are not needed after view,
+ *    they are not stored. See: BGFX_ATTACHMENT_*.
+ */
+BGFX_C_API void bgfx_set_view_attachment_hints(uint8_t _id, uint8_t _dont_care, uint8_t _discard);
+
 /**
  *  Set view into sequential mode. Draw calls will be sorted in the same
  *  order in which submit calls were called.
@@ -18,7 +18,7 @@
 
 #define BGFX_INVALID_HANDLE { bgfx::invalidHandle }
 
-namespace bx { struct ReallocatorI; }
+namespace bx { struct ReallocatorI; struct ReaderI; struct WriterI; }
 
 /// BGFX
 namespace bgfx
@@ -186,6 +186,28 @@ namespace bgfx
 		};
 	};
 
+	/// OpenGL call categories counted by renderer. See:
+	/// `bgfx::Stats::glCalls`.
+	struct GlCall
+	{
+		enum Enum
+		{
+			BindBuffer,
+			BindTexture,
+			ActiveTexture,
+			UseProgram,
+			BindFramebuffer,
+			BindVertexArray,
+			BindSampler,
+			Enable,
+			Uniform,
+			Draw,
+			Invalidate,
+
+			Count
+		};
+	};
+
 	static const uint16_t invalidHandle = UINT16_MAX;
 
 	BGFX_HANDLE(DynamicIndexBufferHandle);
@@ -319,6 +341,114 @@ namespace bgfx
 		uint8_t formats[TextureFormat::Count];
 	};
 
+	/// Per frame resource limits and handle counts, set at `bgfx::init`.
+	/// Frame storage and handle tables are allocated up front from these,
+	/// so small tools can start with less memory and large scenes can
+	/// raise them without changing `config.h`.
+	///
+	/// @remarks
+	///   Fields left at zero take default from matching `BGFX_CONFIG_*`
+	///   define. Handle counts are up to 65535, handle index `UINT16_MAX`
+	///   is invalid handle.
+	///
+	struct Limits
+	{
+		uint16_t maxDrawCalls;          ///< Draw calls, up to `BGFX_CONFIG_MAX_DRAW_CALLS`.
+		uint32_t maxMatrixCache;        ///< Transform matrices.
+		uint32_t maxRectCache;          ///< Scissor rectangles, up to 65535.
+		uint32_t maxConstantBufferSize; ///< Uniform data in bytes.
+		uint32_t transientVbSize;       ///< Transient vertex buffer size in bytes.
+		uint32_t transientIbSize;       ///< Transient index buffer size in bytes.
+
+		uint16_t maxIndexBuffers;         ///< Index buffer handles.
+		uint16_t maxVertexBuffers;        ///< Vertex buffer handles.
+		uint16_t maxDynamicIndexBuffers;  ///< Dynamic index buffer handles.
+		uint16_t maxDynamicVertexBuffers; ///< Dynamic vertex buffer handles.
+		uint16_t maxVertexDecls;          ///< Vertex declaration handles.
+		uint16_t maxShaders;              ///< Shader handles.
+		uint16_t maxPrograms;             ///< Program handles, up to `BGFX_CONFIG_MAX_PROGRAMS`.
+		uint16_t maxTextures;             ///< Texture handles.
+		uint16_t maxFrameBuffers;         ///< Frame buffer handles.
+		uint16_t maxUniforms;             ///< Uniform handles.
+	};
+
+	/// Frame timing and renderer statistics. All times are in CPU timer
+	/// ticks, divide by `cpuTimerFreq` to get seconds.
+	///
+	/// @remarks
+	///   State cache counters are counted since init, and are kept only by
+	///   OpenGL renderer, as are OpenGL call counts of last frame.
+	///
+	struct Stats
+	{
+		int64_t cpuTimerFreq;    ///< CPU timer frequency.
+		int64_t cpuTimeSubmit;   ///< API thread time spent building last frame.
+		int64_t cpuTimeRender;   ///< Render thread time spent executing last frame.
+		int64_t cpuTimeFlip;     ///< Render thread time spent presenting last frame.
+		int64_t waitRender;      ///< API thread time spent waiting for render thread.
+		int64_t waitSubmit;      ///< Render thread time spent waiting for API thread.
+		int64_t waitPacing;      ///< Time spent in last `bgfx::waitFrameStart` call.
+		int64_t predictedRender; ///< Predicted render thread time per frame.
+		int64_t latency;         ///< Submit-to-flip latency of last presented frame.
+		int64_t latencyMin;      ///< Minimum submit-to-flip latency of recent frames.
+		int64_t latencyMax;      ///< Maximum submit-to-flip latency of recent frames.
+
+		uint32_t numDraws;   ///< Draw and compute calls submitted in last frame.
+		uint32_t numDropped; ///< Calls dropped in last frame, over `Limits::maxDrawCalls`.
+
+		uint32_t numVaoStates;       ///< Cached vertex array objects.
+		uint32_t vaoHits;            ///< Vertex array cache hits.
+		uint32_t vaoMisses;          ///< Vertex array cache misses.
+		uint32_t vaoEvictions;       ///< Vertex array objects evicted from full cache.
+		uint32_t numSamplerStates;   ///< Cached sampler objects.
+		uint32_t samplerHits;        ///< Sampler cache hits.
+		uint32_t samplerMisses;      ///< Sampler cache misses.
+		uint32_t samplerEvictions;   ///< Sampler objects evicted from full cache.
+
+		uint32_t glCalls[GlCall::Count];         ///< OpenGL calls issued, per category.
+		uint32_t glCallsFiltered[GlCall::Count]; ///< Redundant OpenGL calls filtered by state shadow.
+	};
+
+	/// Replayed frame statistics. See: `bgfx::replayFrame`.
+	///
+	/// @remarks
+	///   All times are in CPU timer ticks, see `bgfx::Stats::cpuTimerFreq`.
+	///
+	struct ReplayStats
+	{
+		uint32_t frame;        ///< Replayed frame number.
+		uint32_t numCalls;     ///< Number of API calls issued.
+		uint32_t numSubmits;   ///< Number of submit and dispatch calls.
+		int64_t cpuTimeIssue;  ///< Time spent issuing API calls, excluding trace IO.
+		int64_t cpuTimeFrame;  ///< Time spent in `bgfx::frame` call.
+	};
+
+	/// Dynamic buffer backing pool statistics. See:
+	/// `bgfx::getBufferPoolStats`.
+	struct BufferPoolStats
+	{
+		uint64_t size;          ///< Total size of backing buffers in bytes.
+		uint64_t used;          ///< Bytes used by live dynamic buffers.
+		uint32_t largestFree;   ///< Largest free range in bytes.
+		uint32_t numBuffers;    ///< Number of backing buffers.
+		uint32_t numAllocs;     ///< Number of live dynamic buffers.
+		uint32_t numFreeRanges; ///< Number of free ranges.
+		uint32_t numReleased;   ///< Empty backing buffers released so far.
+		uint32_t numRelocated;  ///< Dynamic buffers relocated by compaction so far.
+	};
+
+	/// Transient frame buffer pool statistics. See:
+	/// `bgfx::getTransientFrameBufferStats`.
+	struct TransientFrameBufferStats
+	{
+		uint64_t requestedSize;   ///< Size of frame buffers requested in last frame, without aliasing.
+		uint64_t allocatedSize;   ///< Size of pooled frame buffers.
+		uint32_t numRequests;     ///< Number of frame buffers requested in last frame.
+		uint32_t numFrameBuffers; ///< Number of pooled frame buffers.
+		uint32_t numCreated;      ///< Pooled frame buffers created so far.
+		uint32_t numReleased;     ///< Pooled frame buffers released so far.
+	};
+
 	///
 	struct TransientIndexBuffer
 	{
@@ -326,6 +456,7 @@ namespace bgfx
 		uint32_t size;
 		IndexBufferHandle handle;
 		uint32_t startIndex;
+		bool index32;
 	};
 
 	///
@@ -422,12 +553,121 @@ namespace bgfx
 		uint8_t m_attributes[Attrib::Count];
 	};
 
+	/// Precompiled vertex stream conversion. See: `vertexConvertPlan`.
+	///
+	/// @remarks
+	///   Plan doesn't reference declarations it was compiled from, and it
+	///   can be reused for any number of vertexConvert calls.
+	///
+	struct VertexConvertPlan
+	{
+		struct Op
+		{
+			uint16_t src;   //!< Source attribute offset.
+			uint16_t dest;  //!< Destination attribute offset.
+			uint8_t op;     //!< Set, copy or convert.
+			uint8_t size;   //!< Destination attribute size in bytes.
+			uint8_t unpack; //!< Source attribute kernel.
+			uint8_t pack;   //!< Destination attribute kernel.
+		};
+
+		uint16_t srcStride;  //!< Source vertex stride.
+		uint16_t destStride; //!< Destination vertex stride.
+		uint8_t numOps;      //!< Number of attribute operations.
+		bool copy;           //!< Declarations are the same, vertices are copied.
+		Op ops[Attrib::Count];
+	};
+
+	/// Post-transform vertex cache statistics. See: `analyzeVertexCache`.
+	///
+	struct VertexCacheStats
+	{
+		uint32_t numTransformed; //!< Number of vertex shader invocations.
+		float acmr;              //!< Average cache miss ratio, transformed vertices per triangle.
+		float atvr;              //!< Average transformed vertex ratio, transformed vertices per referenced vertex.
+	};
+
+	/// CPU occlusion buffer. See: `createOcclusionBuffer`.
+	///
+	struct OcclusionBuffer;
+
+	/// Occlusion buffer statistics. See: `getOcclusionStats`.
+	///
+	struct OcclusionStats
+	{
+		uint32_t numOccluders; //!< Occluder meshes added since occlusionBegin.
+		uint32_t numTriangles; //!< Occluder triangles rasterized, after clipping.
+		uint32_t numTested;    //!< Boxes tested since occlusionBegin.
+		uint32_t numVisible;   //!< Boxes found visible since occlusionBegin.
+	};
+
+	/// Mesh or mesh group bounding volumes.
+	///
+	struct MeshBounds
+	{
+		float sphere[4]; //!< Bounding sphere center and radius.
+		float min[3];    //!< Axis aligned bounding box minimum.
+		float max[3];    //!< Axis aligned bounding box maximum.
+	};
+
+	/// Range of mesh triangles, f.e. triangles sharing material.
+	///
+	struct MeshGroup
+	{
+		uint32_t startIndex;  //!< First index in mesh index buffer.
+		uint32_t numIndices;  //!< Number of indices.
+		uint32_t startVertex; //!< First vertex referenced by group.
+		uint32_t numVertices; //!< Number of vertices referenced by group.
+		MeshBounds bounds;    //!< Bounding volumes of group triangles.
+	};
+
+	/// Mesh container contents. See: `meshParse`.
+	///
+	struct MeshInfo
+	{
+		VertexDecl decl;         //!< Vertex stream declaration.
+		const void* vertices;    //!< Vertex stream, points inside container.
+		uint32_t numVertices;    //!< Number of vertices.
+		const void* indices;     //!< Triangle list indices, points inside container.
+		uint32_t numIndices;     //!< Number of indices.
+		bool index32;            //!< Indices are 32-bit.
+		const MeshGroup* groups; //!< Mesh groups, points inside container.
+		uint32_t numGroups;      //!< Number of mesh groups.
+		MeshBounds bounds;       //!< Bounding volumes of whole mesh.
+	};
+
 	/// Pack vec4 into vertex stream format.
 	void vertexPack(const float _input[4], bool _inputNormalized, Attrib::Enum _attr, const VertexDecl& _decl, void* _data, uint32_t _index = 0);
 
 	/// Unpack vec4 from vertex stream format.
 	void vertexUnpack(float _output[4], Attrib::Enum _attr, const VertexDecl& _decl, const void* _data, uint32_t _index = 0);
 
+	/// Pack array of vectors into one attribute of vertex stream.
+	///
+	/// @param _input Input vectors, tightly packed.
+	/// @param _inputNum Number of elements per input vector 1, 2, 3 or 4.
+	///   Missing elements are packed as 0.0f.
+	/// @param _inputNormalized Same as in `vertexPack`.
+	/// @param _attr Attribute semantics.
+	/// @param _decl Vertex stream declaration.
+	/// @param _data Destination vertex stream.
+	/// @param _num Number of vertices to pack.
+	/// @param _index Index of first vertex in vertex stream.
+	///
+	void vertexPackArray(const float* _input, uint8_t _inputNum, bool _inputNormalized, Attrib::Enum _attr, const VertexDecl& _decl, void* _data, uint32_t _num, uint32_t _index = 0);
+
+	/// Unpack one attribute of vertex stream into array of vectors.
+	///
+	/// @param _output Output vectors, tightly packed.
+	/// @param _outputNum Number of elements per output vector 1, 2, 3 or 4.
+	/// @param _attr Attribute semantics.
+	/// @param _decl Vertex stream declaration.
+	/// @param _data Source vertex stream.
+	/// @param _num Number of vertices to unpack.
+	/// @param _index Index of first vertex in vertex stream.
+	///
+	void vertexUnpackArray(float* _output, uint8_t _outputNum, Attrib::Enum _attr, const VertexDecl& _decl, const void* _data, uint32_t _num, uint32_t _index = 0);
+
 	/// Converts vertex stream data from one vertex stream format to another.
 	///
 	/// @param _destDecl Destination vertex stream declaration.
@@ -438,6 +678,29 @@ namespace bgfx
 	///
 	void vertexConvert(const VertexDecl& _destDecl, void* _destData, const VertexDecl& _srcDecl, const void* _srcData, uint32_t _num = 1);
 
+	/// Compile vertex stream conversion plan from one vertex stream format
+	/// to another.
+	///
+	/// @param _plan Conversion plan.
+	/// @param _destDecl Destination vertex stream declaration.
+	/// @param _srcDecl Source vertex stream declaration.
+	///
+	/// @remarks
+	///   Attribute conversions are resolved once into kernels specialised
+	///   for type and number of elements, which are then run over chunks
+	///   of vertices.
+	///
+	void vertexConvertPlan(VertexConvertPlan& _plan, const VertexDecl& _destDecl, const VertexDecl& _srcDecl);
+
+	/// Converts vertex stream data using precompiled conversion plan.
+	///
+	/// @param _plan Conversion plan. See: `vertexConvertPlan`.
+	/// @param _destData Destination vertex stream.
+	/// @param _srcData Source vertex stream data.
+	/// @param _num Number of vertices to convert from source to destination.
+	///
+	void vertexConvert(const VertexConvertPlan& _plan, void* _destData, const void* _srcData, uint32_t _num);
+
 	/// Weld vertices.
 	///
 	/// @param _output Welded vertices remapping table. The size of buffer
@@ -450,6 +713,260 @@ namespace bgfx
 	///
 	uint16_t weldVertices(uint16_t* _output, const VertexDecl& _decl, const void* _data, uint16_t _num, float _epsilon = 0.001f);
 
+	/// Weld vertices.
+	///
+	/// @param _output Welded vertices remapping table. The size of buffer
+	///   must be the same as number of vertices.
+	/// @param _decl Vertex stream declaration.
+	/// @param _data Vertex stream.
+	/// @param _num Number of vertices in vertex stream.
+	/// @param _epsilon Error tolerance for vertex attribute comparison.
+	/// @param _attribMask Attributes compared in addition to position, bit
+	///   `1<<Attrib::Enum` is set for each attribute.
+	/// @param _allocator Allocator for scratch memory. When NULL bgfx
+	///   allocator is used.
+	/// @returns Number of unique vertices after vertex welding.
+	///
+	/// @remarks
+	///   Vertices are bucketed by position quantized to grid of _epsilon
+	///   sized cells, and only neighbouring cells are searched. Search is
+	///   split across job system threads after bgfx::init.
+	///
+	uint32_t weldVertices(uint32_t* _output, const VertexDecl& _decl, const void* _data, uint32_t _num, float _epsilon = 0.001f, uint32_t _attribMask = 0, bx::ReallocatorI* _allocator = NULL);
+
+	/// Reorder triangles for post-transform vertex cache.
+	///
+	/// @param _indices Triangle list indices, reordered in place.
+	/// @param _numIndices Number of indices.
+	/// @param _numVertices Number of vertices referenced by indices.
+	/// @param _allocator Allocator for scratch memory. When NULL bgfx
+	///   allocator is used.
+	///
+	/// @remarks
+	///   Forsyth's linear-speed vertex cache optimisation. Output doesn't
+	///   depend on cache size, and it works well with any FIFO or LRU
+	///   cache.
+	///
+	void optimizeVertexCache(uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices, bx::ReallocatorI* _allocator = NULL);
+
+	/// Reorder triangle clusters to reduce overdraw.
+	///
+	/// @param _indices Triangle list indices, reordered in place. Indices
+	///   should be optimized with `optimizeVertexCache` first.
+	/// @param _numIndices Number of indices.
+	/// @param _decl Vertex stream declaration.
+	/// @param _data Vertex stream.
+	/// @param _numVertices Number of vertices in vertex stream.
+	/// @param _cacheSize Simulated FIFO cache size used to find cluster
+	///   boundaries.
+	/// @param _allocator Allocator for scratch memory. When NULL bgfx
+	///   allocator is used.
+	///
+	/// @remarks
+	///   Mesh is split into clusters where vertex cache is cold, and
+	///   clusters facing away from mesh centroid are drawn first, so that
+	///   they occlude the rest of mesh. Order of triangles within cluster
+	///   is preserved.
+	///
+	void optimizeOverdraw(uint32_t* _indices, uint32_t _numIndices, const VertexDecl& _decl, const void* _data, uint32_t _numVertices, uint32_t _cacheSize = 16, bx::ReallocatorI* _allocator = NULL);
+
+	/// Reorder vertices in order of first use by index buffer.
+	///
+	/// @param _destData Destination vertex stream. It must not overlap
+	///   with source vertex stream.
+	/// @param _remap Vertex remapping table, new vertex index for every
+	///   source vertex, or UINT32_MAX when vertex is not referenced. The
+	///   size of buffer must be the same as number of vertices.
+	/// @param _decl Vertex stream declaration.
+	/// @param _srcData Source vertex stream.
+	/// @param _numVertices Number of vertices in source vertex stream.
+	/// @param _indices Triangle list indices, remapped in place.
+	/// @param _numIndices Number of indices.
+	/// @returns Number of vertices written to destination vertex stream.
+	///
+	uint32_t optimizeVertexFetch(void* _destData, uint32_t* _remap, const VertexDecl& _decl, const void* _srcData, uint32_t _numVertices, uint32_t* _indices, uint32_t _numIndices);
+
+	/// Simulate FIFO post-transform vertex cache.
+	///
+	/// @param _stats Vertex cache statistics.
+	/// @param _indices Triangle list indices.
+	/// @param _numIndices Number of indices.
+	/// @param _numVertices Number of vertices referenced by indices.
+	/// @param _cacheSize Simulated FIFO cache size.
+	/// @param _allocator Allocator for scratch memory. When NULL bgfx
+	///   allocator is used.
+	///
+	void analyzeVertexCache(VertexCacheStats& _stats, const uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices, uint32_t _cacheSize = 16, bx::ReallocatorI* _allocator = NULL);
+
+	/// Test bounding spheres against view frustum.
+	///
+	/// @param _visible Visibility bitmask, bit `1<<(ii&31)` of word
+	///   `ii/32` is set when sphere `ii` is at least partially inside of
+	///   frustum. The size of buffer must be at least `(_num+31)/32`
+	///   words.
+	/// @param _viewProj View-projection matrix.
+	/// @param _x Sphere center x coordinates.
+	/// @param _y Sphere center y coordinates.
+	/// @param _z Sphere center z coordinates.
+	/// @param _radius Sphere radii.
+	/// @param _num Number of spheres.
+	/// @param _oglNdc Projection matrix maps depth to [-1, 1] range
+	///   instead of [0, 1]. See: `bx::mtxProj`.
+	///
+	/// @remarks
+	///   Four spheres are tested per iteration with SIMD, streams don't
+	///   need to be aligned. Call once per view, before submitting draw
+	///   calls.
+	///
+	void cullSpheres(uint32_t* _visible, const void* _viewProj, const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _num, bool _oglNdc = false);
+
+	/// Test axis aligned bounding boxes against view frustum.
+	///
+	/// @param _visible Visibility bitmask, bit `1<<(ii&31)` of word
+	///   `ii/32` is set when box `ii` is at least partially inside of
+	///   frustum. The size of buffer must be at least `(_num+31)/32`
+	///   words.
+	/// @param _viewProj View-projection matrix.
+	/// @param _minX Box minimum x coordinates.
+	/// @param _minY Box minimum y coordinates.
+	/// @param _minZ Box minimum z coordinates.
+	/// @param _maxX Box maximum x coordinates.
+	/// @param _maxY Box maximum y coordinates.
+	/// @param _maxZ Box maximum z coordinates.
+	/// @param _num Number of boxes.
+	/// @param _oglNdc Projection matrix maps depth to [-1, 1] range
+	///   instead of [0, 1]. See: `bx::mtxProj`.
+	///
+	/// @remarks
+	///   Test is conservative, boxes near frustum corners might be
+	///   reported visible even when they are outside.
+	///
+	void cullAabbs(uint32_t* _visible, const void* _viewProj, const float* _minX, const float* _minY, const float* _minZ, const float* _maxX, const float* _maxY, const float* _maxZ, uint32_t _num, bool _oglNdc = false);
+
+	/// Create CPU occlusion buffer.
+	///
+	/// @param _width Depth buffer width, rounded up to multiple of 8.
+	///   Clamped to 65528.
+	/// @param _height Depth buffer height, rounded up to multiple of 8.
+	///   Clamped to 65528.
+	/// @param _allocator Allocator for depth buffer and occluder
+	///   triangles. When NULL bgfx allocator is used.
+	///
+	/// @remarks
+	///   Occluders are rasterized into low resolution depth buffer, with
+	///   farthest depth kept for every 8x8 tile. Bounding boxes are
+	///   tested against tiles first, and against pixels only where tile
+	///   can't reject them. Rasterization and tests are split across job
+	///   system threads after bgfx::init. Buffer can be used without
+	///   bgfx::init.
+	///
+	OcclusionBuffer* createOcclusionBuffer(uint16_t _width, uint16_t _height, bx::ReallocatorI* _allocator = NULL);
+
+	/// Destroy CPU occlusion buffer.
+	void destroyOcclusionBuffer(OcclusionBuffer* _ob);
+
+	/// Start collecting occluders for view.
+	///
+	/// @param _ob Occlusion buffer.
+	/// @param _view View matrix, same as passed to `setViewTransform`.
+	/// @param _proj Projection matrix, same as passed to
+	///   `setViewTransform`.
+	/// @param _oglNdc Projection matrix maps depth to [-1, 1] range
+	///   instead of [0, 1]. See: `bx::mtxProj`.
+	///
+	void occlusionBegin(OcclusionBuffer* _ob, const void* _view, const void* _proj, bool _oglNdc = false);
+
+	/// Add occluder mesh. Mesh is transformed and clipped immediately,
+	/// and buffers can be released after call.
+	///
+	/// @param _ob Occlusion buffer.
+	/// @param _mtx Model matrix. When NULL vertices are in world space.
+	/// @param _vertices Vertices, each vertex starts with float x, y, z
+	///   position.
+	/// @param _stride Vertex stride.
+	/// @param _numVertices Number of vertices.
+	/// @param _indices Triangle list indices.
+	/// @param _numIndices Number of indices.
+	///
+	/// @remarks
+	///   Occluders are rasterized double sided, and they must be fully
+	///   opaque and inside of rendered mesh, otherwise objects behind
+	///   them are rejected when they are visible.
+	///
+	void occlusionAddOccluder(OcclusionBuffer* _ob, const void* _mtx, const void* _vertices, uint16_t _stride, uint32_t _numVertices, const uint32_t* _indices, uint32_t _numIndices);
+
+	/// Rasterize occluders added since `occlusionBegin`. Must be called
+	/// before `occlusionTestAabbs`.
+	void occlusionRasterize(OcclusionBuffer* _ob);
+
+	/// Test world space axis aligned bounding boxes against view frustum
+	/// and occluders.
+	///
+	/// @param _ob Occlusion buffer.
+	/// @param _visible Visibility bitmask, bit `1<<(ii&31)` of word
+	///   `ii/32` is set when box `ii` might be visible. The size of
+	///   buffer must be at least `(_num+31)/32` words.
+	/// @param _minX Box minimum x coordinates.
+	/// @param _minY Box minimum y coordinates.
+	/// @param _minZ Box minimum z coordinates.
+	/// @param _maxX Box maximum x coordinates.
+	/// @param _maxY Box maximum y coordinates.
+	/// @param _maxZ Box maximum z coordinates.
+	/// @param _num Number of boxes.
+	///
+	void occlusionTestAabbs(OcclusionBuffer* _ob, uint32_t* _visible, const float* _minX, const float* _minY, const float* _minZ, const float* _maxX, const float* _maxY, const float* _maxZ, uint32_t _num);
+
+	/// Returns occlusion buffer statistics.
+	void getOcclusionStats(const OcclusionBuffer* _ob, OcclusionStats& _stats);
+
+	/// Read back depth buffer, for debugging.
+	///
+	/// @param _ob Occlusion buffer.
+	/// @param _depth Depth, rows from top to bottom. The size of buffer
+	///   must be at least width*height, rounded up to multiple of 8.
+	///   Pixels not covered by occluders are 1.0.
+	///
+	void readOcclusionDepth(const OcclusionBuffer* _ob, float* _depth);
+
+	/// Write mesh container.
+	///
+	/// @param _writer Writer.
+	/// @param _decl Vertex stream declaration.
+	/// @param _vertices Vertex stream.
+	/// @param _numVertices Number of vertices in vertex stream.
+	/// @param _indices Triangle list indices.
+	/// @param _numIndices Number of indices.
+	/// @param _index32 Indices are 32-bit, otherwise they are 16-bit.
+	/// @param _groups Mesh groups, only index and vertex ranges are used,
+	///   bounding volumes are calculated from vertex positions. When NULL
+	///   single group covering whole mesh is written.
+	/// @param _numGroups Number of mesh groups.
+	/// @returns Number of bytes written.
+	///
+	/// @remarks
+	///   Container is header followed by vertex declaration, groups,
+	///   vertices and indices, each blob starts at 16-byte aligned offset.
+	///   Data is stored in native little endian layout.
+	///
+	uint32_t meshWrite(bx::WriterI* _writer, const VertexDecl& _decl, const void* _vertices, uint32_t _numVertices, const void* _indices, uint32_t _numIndices, bool _index32 = false, const MeshGroup* _groups = NULL, uint32_t _numGroups = 0);
+
+	/// Parse mesh container.
+	///
+	/// @param _info Mesh container contents.
+	/// @param _data Mesh container, f.e. memory mapped file. Must be at
+	///   least 4-byte aligned.
+	/// @param _size Size of mesh container.
+	/// @returns True if container is valid.
+	///
+	/// @remarks
+	///   Nothing is copied, vertices, indices and groups point inside
+	///   container, so they can be passed to `createVertexBuffer` and
+	///   `createIndexBuffer` with `makeRef` while container memory stays
+	///   valid for at least `_numFrames` (see `bgfx::init`) `bgfx::frame`
+	///   calls.
+	///
+	bool meshParse(MeshInfo& _info, const void* _data, uint32_t _size);
+
 	/// Swizzle RGBA8 image to BGRA8.
 	///
 	/// @param _width Width of input image (pixels).
@@ -472,6 +989,56 @@ namespace bgfx
 	///
 	void imageRgba8Downsample2x2(uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src, void* _dst);
 
+	/// Generate full mip chain for RGBA8 image.
+	///
+	/// @param _width Width of input image (pixels).
+	/// @param _height Height of input image (pixels).
+	/// @param _pitch Pitch of input image (bytes).
+	/// @param _src Source image.
+	/// @param _flags
+	///   - `BGFX_MIPS_FILTER_[BOX/KAISER]` - Downsample filter.
+	///   - `BGFX_MIPS_SRGB` - Color channels are filtered in linear space.
+	///   - `BGFX_MIPS_ALPHA_COVERAGE` - Alpha of each mip is scaled to
+	///     preserve alpha test coverage of input image.
+	///
+	/// @param _alphaRef Alpha test reference value used for alpha coverage.
+	/// @param[out] _info When non-`NULL` is specified it returns texture
+	///   information for returned memory.
+	/// @returns Memory with all mip levels, including input image as top
+	///   level, that can be passed directly to `createTexture2D`. `NULL`
+	///   when width or height is above 65535.
+	///
+	/// @remarks
+	///   Large levels are split into bands and processed on multiple threads.
+	///
+	const Memory* imageGenerateMips(uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _src, uint32_t _flags = BGFX_MIPS_NONE, float _alphaRef = 0.5f, TextureInfo* _info = NULL);
+
+	/// Encode BGRA8 image into block compressed texture format.
+	///
+	/// @param _dst Destination image. Must be large enough to hold all
+	///   4x4 blocks covering input image.
+	/// @param _src Source BGRA8 image.
+	/// @param _width Width of input image (pixels).
+	/// @param _height Height of input image (pixels).
+	/// @param _pitch Pitch of input image (bytes).
+	/// @param _format Destination format. Supported formats are
+	///   `TextureFormat::BC1`, `TextureFormat::BC3` and
+	///   `TextureFormat::ETC1`.
+	/// @returns True if image is encoded.
+	///
+	bool imageEncodeFromBgra8(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _pitch, TextureFormat::Enum _format);
+
+	/// Decode block compressed image to BGRA8.
+	///
+	/// @param _dst Destination BGRA8 image.
+	/// @param _src Source image.
+	/// @param _width Width of output image (pixels).
+	/// @param _height Height of output image (pixels).
+	/// @param _pitch Pitch of output image (bytes).
+	/// @param _format Source format.
+	///
+	void imageDecodeToBgra8(void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _pitch, TextureFormat::Enum _format);
+
 	/// Returns supported backend API renderers.
 	uint8_t getSupportedRenderers(RendererType::Enum _enum[RendererType::Count]);
 
@@ -491,9 +1058,17 @@ namespace bgfx
 	///   specified, library uses default CRT allocator. The library assumes
 	///   icustom allocator is thread safe.
 	///
+	/// @param _numFrames Number of frames in flight between API and render
+	///   thread, clamped to 2-4. Deeper pipeline lets API thread absorb
+	///   render thread spikes at cost of one frame of latency per frame.
+	///   Ignored when renderer is not multithreaded.
+	///
+	/// @param _limits Per frame resource limits. When not specified
+	///   defaults from `config.h` are used. See: `bgfx::Limits`
+	///
 	/// @attention C99 equivalent is `bgfx_init`.
 	///
-	void init(RendererType::Enum _type = RendererType::Count, CallbackI* _callback = NULL, bx::ReallocatorI* _reallocator = NULL);
+	void init(RendererType::Enum _type = RendererType::Count, CallbackI* _callback = NULL, bx::ReallocatorI* _reallocator = NULL, uint8_t _numFrames = 2, const Limits* _limits = NULL);
 
 	/// Shutdown bgfx library.
 	///
@@ -548,6 +1123,124 @@ namespace bgfx
 	///
 	const Caps* getCaps();
 
+	/// Returns per frame resource limits set at init.
+	///
+	/// @attention C99 equivalent is `bgfx_get_limits`.
+	///
+	const Limits* getLimits();
+
+	/// Returns frame timing statistics.
+	///
+	/// @returns Pointer to `bgfx::Stats` structure, valid until next
+	///   `bgfx::getStats` call.
+	///
+	/// @remarks
+	///   Library must be initialized.
+	///
+	/// @attention C99 equivalent is `bgfx_get_stats`.
+	///
+	const Stats* getStats();
+
+	/// Returns dynamic index and vertex buffer backing pool statistics.
+	///
+	/// @param _indexPool Dynamic index buffer pool statistics.
+	/// @param _vertexPool Dynamic vertex buffer pool statistics.
+	///
+	/// @remarks
+	///   Dynamic buffers are sub-allocated from large backing buffers.
+	///   Backing buffers that stay empty for
+	///   `BGFX_CONFIG_DYNAMIC_BUFFER_TRIM_FRAMES` frames are released.
+	///   Dynamic buffer living in sparse backing buffer is moved to
+	///   fuller one when it's updated as a whole, so that sparse backing
+	///   buffer drains and can be released.
+	///
+	/// @attention C99 equivalent is `bgfx_get_buffer_pool_stats`.
+	///
+	void getBufferPoolStats(BufferPoolStats& _indexPool, BufferPoolStats& _vertexPool);
+
+	/// Low-latency frame pacing. Blocks until the latest time the next frame
+	/// can start and still be submitted before render thread runs out of
+	/// work. Render and submit times are predicted from recent frames.
+	///
+	/// @remarks
+	///   Call after `bgfx::frame`, right before sampling input. Without
+	///   this call API thread starts next frame as soon as `bgfx::frame`
+	///   returns, which maximizes throughput instead of latency.
+	///
+	/// @attention C99 equivalent is `bgfx_wait_frame_start`.
+	///
+	void waitFrameStart();
+
+	/// Start recording API calls into trace.
+	///
+	/// @param _writer Trace writer. Must stay valid until `bgfx::recordEnd`.
+	/// @returns True if recording started.
+	///
+	/// @remarks
+	///   Every call that changes renderer state is serialized together with
+	///   referenced `bgfx::Memory` and transient buffer contents. Trace is
+	///   written to `_writer` once per frame from `bgfx::frame`. Resources
+	///   created before recording started are not part of trace, start
+	///   recording right after `bgfx::init` to capture everything.
+	///
+	/// @attention C99 equivalent is `bgfx_record_begin`.
+	///
+	bool recordBegin(bx::WriterI* _writer);
+
+	/// Stop recording and flush partially recorded frame.
+	///
+	/// @attention C99 equivalent is `bgfx_record_end`.
+	///
+	void recordEnd();
+
+	/// Start replaying trace written by `bgfx::recordBegin`.
+	///
+	/// @param _reader Trace reader. Must stay valid until `bgfx::replayEnd`.
+	/// @returns True if trace header is valid.
+	///
+	/// @remarks
+	///   Trace doesn't depend on renderer it was recorded with, and can be
+	///   replayed with any renderer including `RendererType::Null`.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_begin`.
+	///
+	bool replayBegin(bx::ReaderI* _reader);
+
+	/// Replay single recorded frame, including `bgfx::frame` call.
+	///
+	/// @param _stats Replayed frame statistics, can be NULL.
+	/// @returns False when end of trace is reached.
+	///
+	/// @remarks
+	///   Whole frame is read from trace before any call is issued, trace IO
+	///   is not included in statistics.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_frame`.
+	///
+	bool replayFrame(ReplayStats* _stats = NULL);
+
+	/// Stop replaying and destroy resources trace didn't destroy.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_end`.
+	///
+	void replayEnd();
+
+	/// Write captured profiler zones as Chrome trace event JSON.
+	///
+	/// @param _writer Trace writer.
+	/// @returns True if any thread captured zones.
+	///
+	/// @remarks
+	///   Zones are captured only while `BGFX_DEBUG_PROFILER` debug flag is
+	///   set, enabling it restarts capture. Each thread keeps last
+	///   `BGFX_CONFIG_PROFILER_MAX_ZONES` zones, memory for them is allocated
+	///   when profiler is enabled first time. Output can be loaded with
+	///   `chrome://tracing`.
+	///
+	/// @attention C99 equivalent is `bgfx_profiler_save`.
+	///
+	bool profilerSave(bx::WriterI* _writer);
+
 	/// Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
 	const Memory* alloc(uint32_t _size);
 
@@ -556,7 +1249,8 @@ namespace bgfx
 
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc` this call
 	/// doesn't allocate memory for data. It just copies pointer to data. You
-	/// must make sure data is available for at least 2 `bgfx::frame` calls.
+	/// must make sure data is available for at least `_numFrames` (see
+	/// `bgfx::init`) `bgfx::frame` calls.
 	const Memory* makeRef(const void* _data, uint32_t _size);
 
 	/// Set debug flags.
@@ -580,10 +1274,14 @@ namespace bgfx
 
 	/// Create static index buffer.
 	///
+	/// @param _mem Index buffer data.
+	/// @param _flags Buffer flags. Index buffer is 32-bit when
+	///   `BGFX_BUFFER_INDEX32` is set, otherwise it's 16-bit.
+	///
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit index buffer requires `BGFX_CAPS_INDEX32`.
 	///
-	IndexBufferHandle createIndexBuffer(const Memory* _mem);
+	IndexBufferHandle createIndexBuffer(const Memory* _mem, uint8_t _flags = BGFX_BUFFER_NONE);
 
 	/// Destroy static index buffer.
 	void destroyIndexBuffer(IndexBufferHandle _handle);
@@ -605,20 +1303,24 @@ namespace bgfx
 	/// Create empty dynamic index buffer.
 	///
 	/// @param _num Number of indices.
+	/// @param _flags Buffer flags. Index buffer is 32-bit when
+	///   `BGFX_BUFFER_INDEX32` is set, otherwise it's 16-bit.
 	///
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit index buffer requires `BGFX_CAPS_INDEX32`.
 	///
-	DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num);
+	DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint8_t _flags = BGFX_BUFFER_NONE);
 
 	/// Create dynamic index buffer and initialized it.
 	///
 	/// @param _mem Index buffer data.
+	/// @param _flags Buffer flags. Index buffer is 32-bit when
+	///   `BGFX_BUFFER_INDEX32` is set, otherwise it's 16-bit.
 	///
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   32-bit index buffer requires `BGFX_CAPS_INDEX32`.
 	///
-	DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem);
+	DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint8_t _flags = BGFX_BUFFER_NONE);
 
 	/// Update dynamic index buffer.
 	///
@@ -627,6 +1329,20 @@ namespace bgfx
 	///
 	void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, const Memory* _mem);
 
+	/// Update part of dynamic index buffer.
+	///
+	/// @param _handle Dynamic index buffer handle.
+	/// @param _startIndex First index to update.
+	/// @param _mem Index buffer data, its size determines number of
+	///   updated indices.
+	///
+	/// @remarks
+	///   Updates of the same buffer issued within a frame are merged on
+	///   render thread when their ranges overlap or touch, and uploaded
+	///   with a single call.
+	///
+	void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem);
+
 	/// Destroy dynamic index buffer.
 	///
 	/// @param _handle Dynamic index buffer handle.
@@ -650,14 +1366,28 @@ namespace bgfx
 	/// Update dynamic vertex buffer.
 	void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, const Memory* _mem);
 
+	/// Update part of dynamic vertex buffer.
+	///
+	/// @param _handle Dynamic vertex buffer handle.
+	/// @param _startVertex First vertex to update.
+	/// @param _mem Vertex buffer data, its size determines number of
+	///   updated vertices.
+	///
+	/// @remarks
+	///   Updates are merged the same way as with
+	///   `bgfx::updateDynamicIndexBuffer`.
+	///
+	void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem);
+
 	/// Destroy dynamic vertex buffer.
 	void destroyDynamicVertexBuffer(DynamicVertexBufferHandle _handle);
 
 	/// Returns true if internal transient index buffer has enough space.
 	///
 	/// @param _num Number of indices.
+	/// @param _index32 Set to `true` for 32-bit indices.
 	///
-	bool checkAvailTransientIndexBuffer(uint32_t _num);
+	bool checkAvailTransientIndexBuffer(uint32_t _num, bool _index32 = false);
 
 	/// Returns true if internal transient vertex buffer has enough space.
 	///
@@ -679,8 +1409,9 @@ namespace bgfx
 	/// @param _numVertices Number of vertices.
 	/// @param _decl Vertex declaration.
 	/// @param _numIndices Number of indices.
+	/// @param _index32 Set to `true` for 32-bit indices.
 	///
-	bool checkAvailTransientBuffers(uint32_t _numVertices, const VertexDecl& _decl, uint32_t _numIndices);
+	bool checkAvailTransientBuffers(uint32_t _numVertices, const VertexDecl& _decl, uint32_t _numIndices, bool _index32 = false);
 
 	/// Allocate transient index buffer.
 	///
@@ -688,13 +1419,14 @@ namespace bgfx
 	///   for the duration of frame, and it can be reused for multiple draw
 	///   calls.
 	/// @param _num Number of indices to allocate.
+	/// @param _index32 Set to `true` for 32-bit indices.
 	///
 	/// @remarks
 	///   1. You must call setIndexBuffer after alloc in order to avoid memory
 	///      leak.
-	///   2. Only 16-bit index buffer is supported.
+	///   2. 32-bit indices require `BGFX_CAPS_INDEX32`.
 	///
-	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num);
+	void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32 = false);
 
 	/// Allocate transient vertex buffer.
 	///
@@ -715,9 +1447,10 @@ namespace bgfx
 	/// true.
 	///
 	/// @remarks
-	///   Only 16-bit index buffer is supported.
+	///   More than 65535 vertices can be addressed only with 32-bit
+	///   indices.
 	///
-	bool allocTransientBuffers(TransientVertexBuffer* _tvb, const VertexDecl& _decl, uint16_t _numVertices, TransientIndexBuffer* _tib, uint16_t _numIndices);
+	bool allocTransientBuffers(TransientVertexBuffer* _tvb, const VertexDecl& _decl, uint32_t _numVertices, TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32 = false);
 
 	/// Allocate instance data buffer.
 	///
@@ -786,6 +1519,10 @@ namespace bgfx
 	/// @param _numMips
 	/// @param _format
 	/// @param _flags
+	///   - `BGFX_TEXTURE_COMPRESS_[BC1/BC3/ETC1]` - When `_format` is
+	///     `TextureFormat::BGRA8`, texture is block compressed on render
+	///     thread before upload.
+	///
 	/// @param _mem
 	///
 	TextureHandle createTexture2D(uint16_t _width, uint16_t _height, uint8_t _numMips, TextureFormat::Enum _format, uint32_t _flags = BGFX_TEXTURE_NONE, const Memory* _mem = NULL);
@@ -912,6 +1649,40 @@ namespace bgfx
 	/// Destroy frame buffer.
 	void destroyFrameBuffer(FrameBufferHandle _handle);
 
+	/// Allocate transient frame buffer, valid for views `_firstView` to
+	/// `_lastView` of current frame only.
+	///
+	/// @param _width Texture width.
+	/// @param _height Texture height.
+	/// @param _format Texture format.
+	/// @param _firstView First view using frame buffer, usually the one
+	///   rendering into it.
+	/// @param _lastView Last view using frame buffer, usually the last one
+	///   sampling it.
+	/// @param _textureFlags Texture flags.
+	///
+	/// @returns Handle to frame buffer object, invalid when view range is
+	///   invalid.
+	///
+	/// @remarks
+	///   Frame buffers are pooled, and requests with the same size, format
+	///   and texture flags whose view ranges don't overlap share the same
+	///   textures. Content is undefined at `_firstView` and must not be
+	///   used after `_lastView`, or in next frame.
+	///   Pooled frame buffers unused for
+	///   `BGFX_CONFIG_TRANSIENT_FRAME_BUFFER_TRIM_FRAMES` frames are
+	///   released. Don't destroy transient frame buffer.
+	///
+	/// @attention C99 equivalent is `bgfx_alloc_transient_frame_buffer`.
+	///
+	FrameBufferHandle allocTransientFrameBuffer(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint8_t _firstView, uint8_t _lastView, uint32_t _textureFlags = BGFX_TEXTURE_U_CLAMP|BGFX_TEXTURE_V_CLAMP);
+
+	/// Returns transient frame buffer pool statistics.
+	///
+	/// @attention C99 equivalent is `bgfx_get_transient_frame_buffer_stats`.
+	///
+	void getTransientFrameBufferStats(TransientFrameBufferStats& _stats);
+
 	/// Create shader uniform parameter.
 	///
 	/// @param _name Uniform name in shader.
@@ -1020,6 +1791,25 @@ namespace bgfx
 	///
 	void setViewClear(uint8_t _id, uint8_t _flags, float _depth, uint8_t _stencil, uint8_t _0 = UINT8_MAX, uint8_t _1 = UINT8_MAX, uint8_t _2 = UINT8_MAX, uint8_t _3 = UINT8_MAX, uint8_t _4 = UINT8_MAX, uint8_t _5 = UINT8_MAX, uint8_t _6 = UINT8_MAX, uint8_t _7 = UINT8_MAX);
 
+	/// Set view frame buffer attachment hints. Attachments are loaded at
+	/// the start of view unless cleared, and stored at the end of view.
+	///
+	/// @param _id View id.
+	/// @param _dontCare Attachments whose previous contents are not needed
+	///   by view, they are not loaded. See: `BGFX_ATTACHMENT_*`.
+	/// @param _discard Attachments whose contents are not needed after
+	///   view, they are not stored. See: `BGFX_ATTACHMENT_*`.
+	///
+	/// @remarks
+	///   Hints are used only by OpenGL renderer when
+	///   `GL_ARB_invalidate_subdata`, `GL_EXT_discard_framebuffer` or
+	///   OpenGL ES 3.0 is available. View that doesn't cover whole frame
+	///   buffer requires glInvalidateSubFramebuffer, otherwise hints are
+	///   ignored. Color of MSAA frame buffer is never discarded since it's
+	///   resolved after view.
+	///
+	void setViewAttachmentHints(uint8_t _id, uint8_t _dontCare, uint8_t _discard);
+
 	/// Set view into sequential mode. Draw calls will be sorted in the same
 	/// order in which submit calls were called.
 	void setViewSeq(uint8_t _id, bool _enabled);
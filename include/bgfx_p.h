@@ -66,6 +66,7 @@ namespace bgfx
 #include <bx/bx.h>
 #include <bx/debug.h>
 #include <bx/float4x4_t.h>
+#include <bx/cull.h>
 #include <bx/blockalloc.h>
 #include <bx/endian.h>
 #include <bx/handlealloc.h>
@@ -83,6 +84,7 @@ namespace bgfx
 
 #define BGFX_CHUNK_MAGIC_CSH BX_MAKEFOURCC('C', 'S', 'H', 0x1)
 #define BGFX_CHUNK_MAGIC_FSH BX_MAKEFOURCC('F', 'S', 'H', 0x3)
+#define BGFX_CHUNK_MAGIC_REC BX_MAKEFOURCC('R', 'E', 'C', 0x1)
 #define BGFX_CHUNK_MAGIC_TEX BX_MAKEFOURCC('T', 'E', 'X', 0x0)
 #define BGFX_CHUNK_MAGIC_VSH BX_MAKEFOURCC('V', 'S', 'H', 0x3)
 
@@ -126,6 +128,7 @@ namespace stl
 
 #include <bx/cpu.h>
 #include <bx/thread.h>
+#include <bx/jobsystem.h>
 #include <bx/timer.h>
 
 #include "vertexdecl.h"
@@ -200,6 +203,12 @@ namespace bgfx
 		uint8_t m_flags;
 	};
 
+	struct AttachmentHints
+	{
+		uint8_t m_dontCare;
+		uint8_t m_discard;
+	};
+
 	struct Rect
 	{
 		void clear()
@@ -251,11 +260,82 @@ namespace bgfx
 	extern const uint32_t g_uniformTypeSize[UniformType::Count+1];
 	extern CallbackI* g_callback;
 	extern bx::ReallocatorI* g_allocator;
+#if BX_CONFIG_SUPPORTS_THREADING
+	extern bx::JobSystem* g_jobSystem;
+#endif // BX_CONFIG_SUPPORTS_THREADING
 	extern Caps g_caps;
+	extern Limits g_limits;
+
+	// Handle indexed tables are sized from g_limits at init, entries are
+	// value initialized in place.
+	template<typename Ty>
+	inline Ty* createHandleTable(uint32_t _num)
+	{
+		Ty* table = (Ty*)BX_ALLOC(g_allocator, _num*sizeof(Ty) );
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			::new(&table[ii]) Ty();
+		}
+
+		return table;
+	}
+
+	template<typename Ty>
+	inline void destroyHandleTable(Ty* _table, uint32_t _num)
+	{
+		if (NULL != _table)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_table[ii].~Ty();
+			}
+
+			BX_FREE(g_allocator, _table);
+		}
+	}
+
+#if BGFX_CONFIG_PROFILER
+#	define BGFX_PROFILER_SCOPE(_name) ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name)
+#else
+#	define BGFX_PROFILER_SCOPE(_name) BX_NOOP()
+#endif // BGFX_CONFIG_PROFILER
+
+	extern volatile bool g_profilerEnabled;
+
+	void profilerEnable(bool _enable);
+	void profilerSetThreadName(const char* _name);
+	void profilerReleaseThread();
+	void profilerPush(const char* _name, int64_t _begin, int64_t _end);
+
+	// Profiler zone covering lifetime of scope. Zones are kept in
+	// thread-local ring, when capture is off it costs single branch.
+	class ProfilerScope
+	{
+	public:
+		ProfilerScope(const char* _name)
+			: m_name(_name)
+			, m_begin(g_profilerEnabled ? bx::getHPCounter() : 0)
+		{
+		}
+
+		~ProfilerScope()
+		{
+			if (0 != m_begin)
+			{
+				profilerPush(m_name, m_begin, bx::getHPCounter() );
+			}
+		}
+
+	private:
+		const char* m_name;
+		int64_t m_begin;
+	};
 
 	void setGraphicsDebuggerPresent(bool _present);
 	bool isGraphicsDebuggerPresent();
 	void release(const Memory* _mem);
+	void parallelFor(uint32_t _num, uint32_t _grain, bx::ParallelForFn _fn, void* _userData);
+	bx::ReallocatorI* scratchAllocator(bx::ReallocatorI* _allocator);
 	const char* getAttribName(Attrib::Enum _attr);
 
 	inline uint32_t gcd(uint32_t _a, uint32_t _b)
@@ -417,6 +497,21 @@ namespace bgfx
 		TransientIndexBuffer* m_ib;
 		VertexDecl m_decl;
 		ProgramHandle m_program;
+
+		// Vertex buffer holds quad for every cell, at cell index times 4,
+		// and it's kept between frames. Only rows that differ from cached
+		// m_cells are encoded, and only [m_vbStart, m_vbEnd) vertex range,
+		// and index buffer when m_ibUpdate is set, are uploaded.
+		uint8_t* m_cells;
+		uint32_t m_numVertices;
+		uint32_t m_vbStart;
+		uint32_t m_vbEnd;
+		uint32_t m_numIndices;
+		uint16_t m_width;
+		uint16_t m_height;
+		bool m_small;
+		bool m_ibUpdate;
+		bool m_invalidate;
 		bool m_init;
 	};
 
@@ -472,6 +567,237 @@ namespace bgfx
 		uint32_t m_values[maxKeys];
 	};
 
+	// Fixed capacity cache with least recently used eviction. Open
+	// addressing table with linear probing maps hash to entry, entries
+	// are compared by full key, so hash collisions don't alias. Capacity
+	// must be power of 2.
+	template <typename KeyT, typename ValueT, uint16_t maxKeys>
+	class LruCacheT
+	{
+	public:
+		LruCacheT()
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			BX_STATIC_ASSERT(0 == (maxKeys & (maxKeys-1) ) && maxKeys <= 0x4000);
+
+			memset(m_table, 0xff, sizeof(m_table) );
+			m_head = invalidHandle;
+			m_tail = invalidHandle;
+			m_free = invalidHandle;
+			m_num  = 0;
+			m_used = 0;
+			m_hits = 0;
+			m_misses = 0;
+			m_evictions = 0;
+		}
+
+		ValueT* find(const KeyT& _key, uint32_t _hash)
+		{
+			for (uint32_t slot = _hash&tableMask; invalidHandle != m_table[slot]; slot = (slot+1)&tableMask)
+			{
+				const uint16_t idx = m_table[slot];
+				Entry& entry = m_entry[idx];
+				if (entry.m_hash == _hash
+				&&  entry.m_key == _key)
+				{
+					m_hits++;
+					unlink(idx);
+					linkHead(idx);
+					return &entry.m_value;
+				}
+			}
+
+			m_misses++;
+			return NULL;
+		}
+
+		// Returns true when least recently used entry had to be evicted
+		// to make room, evicted value is returned in _evicted.
+		bool add(const KeyT& _key, uint32_t _hash, const ValueT& _value, ValueT& _evicted)
+		{
+			const bool full = maxKeys == m_num;
+			if (full)
+			{
+				evict(_evicted);
+				m_evictions++;
+			}
+
+			uint16_t idx = m_free;
+			if (invalidHandle != idx)
+			{
+				m_free = m_entry[idx].m_next;
+			}
+			else
+			{
+				idx = m_used++;
+			}
+
+			Entry& entry = m_entry[idx];
+			entry.m_key   = _key;
+			entry.m_value = _value;
+			entry.m_hash  = _hash;
+			linkHead(idx);
+
+			uint32_t slot = _hash&tableMask;
+			while (invalidHandle != m_table[slot])
+			{
+				slot = (slot+1)&tableMask;
+			}
+			m_table[slot] = idx;
+			m_num++;
+
+			return full;
+		}
+
+		// Removes one entry with matching hash.
+		bool remove(uint32_t _hash, ValueT& _value)
+		{
+			for (uint32_t slot = _hash&tableMask; invalidHandle != m_table[slot]; slot = (slot+1)&tableMask)
+			{
+				const uint16_t idx = m_table[slot];
+				if (m_entry[idx].m_hash == _hash)
+				{
+					_value = m_entry[idx].m_value;
+					remove(slot, idx);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Removes least recently used entry.
+		bool evict(ValueT& _value)
+		{
+			if (invalidHandle == m_tail)
+			{
+				return false;
+			}
+
+			const uint16_t idx = m_tail;
+			uint32_t slot = m_entry[idx].m_hash&tableMask;
+			while (idx != m_table[slot])
+			{
+				slot = (slot+1)&tableMask;
+			}
+
+			_value = m_entry[idx].m_value;
+			remove(slot, idx);
+			return true;
+		}
+
+		uint32_t getCount() const
+		{
+			return m_num;
+		}
+
+		uint32_t getHits() const
+		{
+			return m_hits;
+		}
+
+		uint32_t getMisses() const
+		{
+			return m_misses;
+		}
+
+		uint32_t getEvictions() const
+		{
+			return m_evictions;
+		}
+
+	private:
+		void remove(uint32_t _slot, uint16_t _idx)
+		{
+			// Backward shift deletion, moves following entries of the
+			// same probe sequence into the hole.
+			uint32_t hole = _slot;
+			for (uint32_t slot = (_slot+1)&tableMask; invalidHandle != m_table[slot]; slot = (slot+1)&tableMask)
+			{
+				const uint32_t home = m_entry[m_table[slot] ].m_hash&tableMask;
+				if ( ( (slot-home)&tableMask) >= ( (slot-hole)&tableMask) )
+				{
+					m_table[hole] = m_table[slot];
+					hole = slot;
+				}
+			}
+			m_table[hole] = invalidHandle;
+
+			unlink(_idx);
+			m_entry[_idx].m_next = m_free;
+			m_free = _idx;
+			m_num--;
+		}
+
+		void linkHead(uint16_t _idx)
+		{
+			Entry& entry = m_entry[_idx];
+			entry.m_prev = invalidHandle;
+			entry.m_next = m_head;
+
+			if (invalidHandle != m_head)
+			{
+				m_entry[m_head].m_prev = _idx;
+			}
+			else
+			{
+				m_tail = _idx;
+			}
+
+			m_head = _idx;
+		}
+
+		void unlink(uint16_t _idx)
+		{
+			Entry& entry = m_entry[_idx];
+
+			if (invalidHandle != entry.m_prev)
+			{
+				m_entry[entry.m_prev].m_next = entry.m_next;
+			}
+			else
+			{
+				m_head = entry.m_next;
+			}
+
+			if (invalidHandle != entry.m_next)
+			{
+				m_entry[entry.m_next].m_prev = entry.m_prev;
+			}
+			else
+			{
+				m_tail = entry.m_prev;
+			}
+		}
+
+		struct Entry
+		{
+			KeyT m_key;
+			ValueT m_value;
+			uint32_t m_hash;
+			uint16_t m_prev;
+			uint16_t m_next;
+		};
+
+		// Table is twice the capacity to keep probe sequences short.
+		enum { tableMask = maxKeys*2-1 };
+
+		Entry m_entry[maxKeys];
+		uint16_t m_table[tableMask+1];
+		uint16_t m_head;
+		uint16_t m_tail;
+		uint16_t m_free;
+		uint16_t m_num;
+		uint16_t m_used;
+		uint32_t m_hits;
+		uint32_t m_misses;
+		uint32_t m_evictions;
+	};
+
 	struct ClearQuad
 	{
 		ClearQuad()
@@ -514,10 +840,16 @@ namespace bgfx
 		uint8_t m_type;
 	};
 
+	inline uint32_t hashName(const char* _name, uint32_t _len)
+	{
+		return bx::hashMurmur2A(_name, _len);
+	}
+
 	const char* getUniformTypeName(UniformType::Enum _enum);
 	UniformType::Enum nameToUniformTypeEnum(const char* _name);
 	const char* getPredefinedUniformName(PredefinedUniform::Enum _enum);
 	PredefinedUniform::Enum nameToPredefinedUniformEnum(const char* _name);
+	PredefinedUniform::Enum nameToPredefinedUniformEnum(const char* _name, uint32_t _len, uint32_t _hash);
 
 	struct CommandBuffer
 	{
@@ -737,8 +1069,16 @@ namespace bgfx
 	struct MatrixCache
 	{
 		MatrixCache()
-			: m_num(1)
+			: m_cache(NULL)
+			, m_num(1)
+			, m_max(0)
+		{
+		}
+
+		void init(Matrix4* _cache, uint32_t _max)
 		{
+			m_cache = _cache;
+			m_max   = _max;
 			m_cache[0].setIdentity();
 		}
 
@@ -750,8 +1090,8 @@ namespace bgfx
 		uint32_t reserve(uint16_t* _num)
 		{
 			uint32_t num = *_num;
-			BX_CHECK(m_num+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", m_num+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::uint32_min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-m_num);
+			BX_CHECK(m_num+num < m_max, "Matrix cache overflow. %d (max: %d)", m_num+num, m_max);
+			num = bx::uint32_min(num, m_max-m_num);
 			uint32_t first = m_num;
 			m_num += num;
 			*_num = (uint16_t)num;
@@ -780,15 +1120,24 @@ namespace bgfx
 			return uint32_t( (const Matrix4*)_ptr - m_cache);
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		Matrix4* m_cache;
 		uint32_t m_num;
+		uint32_t m_max;
 	};
 
 	struct RectCache
 	{
 		RectCache()
-			: m_num(0)
+			: m_cache(NULL)
+			, m_num(0)
+			, m_max(0)
+		{
+		}
+
+		void init(Rect* _cache, uint32_t _max)
 		{
+			m_cache = _cache;
+			m_max   = _max;
 		}
 
 		void reset()
@@ -798,22 +1147,24 @@ namespace bgfx
 
 		uint32_t add(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
-			BX_CHECK(m_num+1 < BGFX_CONFIG_MAX_RECT_CACHE, "Rect cache overflow. %d (max: %d)", m_num, BGFX_CONFIG_MAX_RECT_CACHE);
+			BX_CHECK(m_num < m_max, "Rect cache overflow. %d (max: %d)", m_num, m_max);
 
-			uint32_t first = m_num;
-			Rect& rect = m_cache[m_num];
+			// When full, last rect is overwritten.
+			uint32_t first = bx::uint32_min(m_num, m_max-1);
+			Rect& rect = m_cache[first];
 
 			rect.m_x = _x;
 			rect.m_y = _y;
 			rect.m_width = _width;
 			rect.m_height = _height;
 
-			m_num++;
+			m_num = bx::uint32_min(m_num+1, m_max);
 			return first;
 		}
 
-		Rect m_cache[BGFX_CONFIG_MAX_RECT_CACHE];
+		Rect* m_cache;
 		uint32_t m_num;
+		uint32_t m_max;
 	};
 
 #define CONSTANT_OPCODE_TYPE_SHIFT 27
@@ -938,6 +1289,147 @@ namespace bgfx
 		char m_buffer[8];
 	};
 
+	// Hash map keyed by interned names. Names are copied into single
+	// arena, and entries keep hash so lookups and growth never hash or
+	// allocate strings. Names are never removed, only their values.
+	template<typename Ty>
+	class NameHashMap
+	{
+	public:
+		NameHashMap()
+			: m_entry(NULL)
+			, m_slot(NULL)
+			, m_arena(NULL)
+			, m_num(0)
+			, m_max(0)
+			, m_arenaSize(0)
+			, m_arenaMax(0)
+		{
+		}
+
+		~NameHashMap()
+		{
+			BX_FREE(g_allocator, m_entry);
+			BX_FREE(g_allocator, m_slot);
+			BX_FREE(g_allocator, m_arena);
+		}
+
+		uint32_t find(const char* _name, uint32_t _len, uint32_t _hash) const
+		{
+			if (0 == m_num)
+			{
+				return UINT32_MAX;
+			}
+
+			const uint32_t mask = m_max*2-1;
+			for (uint32_t slot = _hash&mask;; slot = (slot+1)&mask)
+			{
+				const uint32_t idx = m_slot[slot];
+				if (UINT32_MAX == idx)
+				{
+					return UINT32_MAX;
+				}
+
+				const Entry& entry = m_entry[idx];
+				if (entry.m_hash == _hash
+				&&  entry.m_len  == _len
+				&&  0 == memcmp(&m_arena[entry.m_offset], _name, _len) )
+				{
+					return idx;
+				}
+			}
+		}
+
+		uint32_t add(const char* _name, uint32_t _len, uint32_t _hash, const Ty& _value)
+		{
+			uint32_t idx = find(_name, _len, _hash);
+			if (UINT32_MAX == idx)
+			{
+				if (m_num == m_max)
+				{
+					grow();
+				}
+
+				if (m_arenaSize + _len + 1 > m_arenaMax)
+				{
+					m_arenaMax = bx::uint32_max(m_arenaMax*2, m_arenaSize + _len + 1);
+					m_arena = (char*)BX_REALLOC(g_allocator, m_arena, m_arenaMax);
+				}
+
+				idx = m_num;
+				++m_num;
+
+				Entry& entry = m_entry[idx];
+				entry.m_hash   = _hash;
+				entry.m_offset = m_arenaSize;
+				entry.m_len    = _len;
+				memcpy(&m_arena[m_arenaSize], _name, _len);
+				m_arena[m_arenaSize + _len] = '\0';
+				m_arenaSize += _len + 1;
+
+				insertSlot(_hash, idx);
+			}
+
+			m_entry[idx].m_value = _value;
+			return idx;
+		}
+
+		Ty& getValue(uint32_t _idx)
+		{
+			return m_entry[_idx].m_value;
+		}
+
+		const Ty& getValue(uint32_t _idx) const
+		{
+			return m_entry[_idx].m_value;
+		}
+
+		const char* getName(uint32_t _idx) const
+		{
+			return &m_arena[m_entry[_idx].m_offset];
+		}
+
+	private:
+		void grow()
+		{
+			m_max   = bx::uint32_max(64, m_max*2);
+			m_entry = (Entry*)BX_REALLOC(g_allocator, m_entry, m_max*sizeof(Entry) );
+
+			BX_FREE(g_allocator, m_slot);
+			m_slot = (uint32_t*)BX_ALLOC(g_allocator, m_max*2*sizeof(uint32_t) );
+			memset(m_slot, 0xff, m_max*2*sizeof(uint32_t) );
+
+			for (uint32_t ii = 0; ii < m_num; ++ii)
+			{
+				insertSlot(m_entry[ii].m_hash, ii);
+			}
+		}
+
+		void insertSlot(uint32_t _hash, uint32_t _idx)
+		{
+			const uint32_t mask = m_max*2-1;
+			uint32_t slot = _hash&mask;
+			for (; UINT32_MAX != m_slot[slot]; slot = (slot+1)&mask) {};
+			m_slot[slot] = _idx;
+		}
+
+		struct Entry
+		{
+			Ty m_value;
+			uint32_t m_hash;
+			uint32_t m_offset;
+			uint32_t m_len;
+		};
+
+		Entry* m_entry;
+		uint32_t* m_slot;
+		char* m_arena;
+		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_arenaSize;
+		uint32_t m_arenaMax;
+	};
+
 	typedef const void* (*UniformFn)(const void* _data);
 
 	struct UniformInfo
@@ -960,10 +1452,16 @@ namespace bgfx
 
  		const UniformInfo* find(const char* _name) const
  		{
-			UniformHashMap::const_iterator it = m_uniforms.find(_name);
-			if (it != m_uniforms.end() )
+			uint32_t len = (uint32_t)strlen(_name);
+			return find(_name, len, hashName(_name, len) );
+		}
+
+ 		const UniformInfo* find(const char* _name, uint32_t _len, uint32_t _hash) const
+ 		{
+			uint32_t idx = m_uniforms.find(_name, _len, _hash);
+			if (UINT32_MAX != idx)
 			{
-				return &it->second;
+				return &m_uniforms.getValue(idx);
 			}
 
  			return NULL;
@@ -971,29 +1469,18 @@ namespace bgfx
 
 		const UniformInfo& add(UniformHandle _handle, const char* _name, const void* _data, UniformFn _func = NULL)
 		{
-			UniformHashMap::iterator it = m_uniforms.find(_name);
-			if (it == m_uniforms.end() )
-			{
-				UniformInfo info;
-				info.m_data   = _data;
-				info.m_func   = _func;
-				info.m_handle = _handle;
-
-				stl::pair<UniformHashMap::iterator, bool> result = m_uniforms.insert(UniformHashMap::value_type(_name, info) );
-				return result.first->second;
-			}
-
-			UniformInfo& info = it->second;
+			UniformInfo info;
 			info.m_data   = _data;
 			info.m_func   = _func;
 			info.m_handle = _handle;
 
-			return info;
+			uint32_t len = (uint32_t)strlen(_name);
+			uint32_t idx = m_uniforms.add(_name, len, hashName(_name, len), info);
+			return m_uniforms.getValue(idx);
 		}
 
  	private:
- 		typedef stl::unordered_map<stl::string, UniformInfo> UniformHashMap;
- 		UniformHashMap m_uniforms;
+ 		NameHashMap<UniformInfo> m_uniforms;
  	};
 
 	struct Sampler
@@ -1021,6 +1508,7 @@ namespace bgfx
 			m_numInstances = 1;
 			m_num = 1;
 			m_scissor = UINT16_MAX;
+			m_index32 = false;
 			m_vertexBuffer.idx = invalidHandle;
 			m_vertexDecl.idx = invalidHandle;
 			m_indexBuffer.idx = invalidHandle;
@@ -1048,6 +1536,7 @@ namespace bgfx
 		uint16_t m_numInstances;
 		uint16_t m_num;
 		uint16_t m_scissor;
+		bool m_index32;
 
 		VertexBufferHandle m_vertexBuffer;
 		VertexDeclHandle   m_vertexDecl;
@@ -1124,6 +1613,10 @@ namespace bgfx
 		IndexBufferHandle m_handle;
 		uint32_t m_offset;
 		uint32_t m_size;
+		uint32_t m_startIndex;
+		uint32_t m_numIndices;
+		uint32_t m_drawFrame;
+		uint8_t m_flags;
 	};
 
 	struct DynamicVertexBuffer
@@ -1134,6 +1627,7 @@ namespace bgfx
 		uint32_t m_startVertex;
 		uint32_t m_numVertices;
 		uint32_t m_stride;
+		uint32_t m_drawFrame;
 		VertexDeclHandle m_decl;
 	};
 
@@ -1142,8 +1636,13 @@ namespace bgfx
 		BX_CACHE_LINE_ALIGN_MARKER();
 
 		Frame()
-			: m_waitSubmit(0)
+			: m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_renderItem(NULL)
+			, m_maxDrawCalls(0)
+			, m_waitSubmit(0)
 			, m_waitRender(0)
+			, m_submitTime(0)
 		{
 		}
 
@@ -1151,9 +1650,55 @@ namespace bgfx
 		{
 		}
 
-		void create()
-		{
-			m_constantBuffer = ConstantBuffer::create(BGFX_CONFIG_MAX_CONSTANT_BUFFER_SIZE);
+		void create(const Limits& _limits)
+		{
+			// Per draw arrays, caches and freed handle lists share one
+			// allocation, ordered by alignment. Matrix cache comes first
+			// and owns the allocation.
+			m_maxDrawCalls = _limits.maxDrawCalls;
+			const size_t size = 0
+				+ _limits.maxMatrixCache*sizeof(Matrix4)
+				+ m_maxDrawCalls*sizeof(RenderItem)
+				+ m_maxDrawCalls*sizeof(uint64_t)
+				+ _limits.maxRectCache*sizeof(Rect)
+				+ m_maxDrawCalls*sizeof(uint16_t)
+				+ _limits.maxIndexBuffers*sizeof(IndexBufferHandle)
+				+ _limits.maxVertexDecls*sizeof(VertexDeclHandle)
+				+ _limits.maxVertexBuffers*sizeof(VertexBufferHandle)
+				+ _limits.maxShaders*sizeof(ShaderHandle)
+				+ _limits.maxPrograms*sizeof(ProgramHandle)
+				+ _limits.maxTextures*sizeof(TextureHandle)
+				+ _limits.maxFrameBuffers*sizeof(FrameBufferHandle)
+				+ _limits.maxUniforms*sizeof(UniformHandle)
+				;
+			uint8_t* data = (uint8_t*)BX_ALIGNED_ALLOC(g_allocator, size, 16);
+			m_matrixCache.init( (Matrix4*)data, _limits.maxMatrixCache);
+			data += _limits.maxMatrixCache*sizeof(Matrix4);
+			m_renderItem = (RenderItem*)data;
+			data += m_maxDrawCalls*sizeof(RenderItem);
+			m_sortKeys = (uint64_t*)data;
+			data += m_maxDrawCalls*sizeof(uint64_t);
+			m_rectCache.init( (Rect*)data, _limits.maxRectCache);
+			data += _limits.maxRectCache*sizeof(Rect);
+			m_sortValues = (uint16_t*)data;
+			data += m_maxDrawCalls*sizeof(uint16_t);
+			m_freeIndexBufferHandle = (IndexBufferHandle*)data;
+			data += _limits.maxIndexBuffers*sizeof(IndexBufferHandle);
+			m_freeVertexDeclHandle = (VertexDeclHandle*)data;
+			data += _limits.maxVertexDecls*sizeof(VertexDeclHandle);
+			m_freeVertexBufferHandle = (VertexBufferHandle*)data;
+			data += _limits.maxVertexBuffers*sizeof(VertexBufferHandle);
+			m_freeShaderHandle = (ShaderHandle*)data;
+			data += _limits.maxShaders*sizeof(ShaderHandle);
+			m_freeProgramHandle = (ProgramHandle*)data;
+			data += _limits.maxPrograms*sizeof(ProgramHandle);
+			m_freeTextureHandle = (TextureHandle*)data;
+			data += _limits.maxTextures*sizeof(TextureHandle);
+			m_freeFrameBufferHandle = (FrameBufferHandle*)data;
+			data += _limits.maxFrameBuffers*sizeof(FrameBufferHandle);
+			m_freeUniformHandle = (UniformHandle*)data;
+
+			m_constantBuffer = ConstantBuffer::create(_limits.maxConstantBufferSize);
 			reset();
 			start();
 			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
@@ -1163,6 +1708,7 @@ namespace bgfx
 		{
 			ConstantBuffer::destroy(m_constantBuffer);
 			BX_DELETE(g_allocator, m_textVideoMem);
+			BX_ALIGNED_FREE(g_allocator, m_matrixCache.m_cache, 16);
 		}
 
 		void reset()
@@ -1205,7 +1751,7 @@ namespace bgfx
 				BX_TRACE("Too many draw calls: %d, dropped %d (max: %d)"
 					, m_num+m_numDropped
 					, m_numDropped
-					, BGFX_CONFIG_MAX_DRAW_CALLS
+					, m_maxDrawCalls
 					);
 			}
 		}
@@ -1264,11 +1810,12 @@ namespace bgfx
 			m_draw.m_num    = _num;
 		}
 
-		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
+		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices, bool _index32)
 		{
 			m_draw.m_startIndex  = _firstIndex;
 			m_draw.m_numIndices  = _numIndices;
 			m_draw.m_indexBuffer = _handle;
+			m_draw.m_index32     = _index32;
 		}
 
 		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -1276,12 +1823,13 @@ namespace bgfx
 			m_draw.m_indexBuffer = _tib->handle;
 			m_draw.m_startIndex  = _firstIndex;
 			m_draw.m_numIndices  = _numIndices;
+			m_draw.m_index32     = _tib->index32;
 			m_discard = 0 == _numIndices;
 		}
 
 		void setVertexBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _numVertices)
 		{
-			BX_CHECK(_handle.idx < BGFX_CONFIG_MAX_VERTEX_BUFFERS, "Invalid vertex buffer handle. %d (< %d)", _handle.idx, BGFX_CONFIG_MAX_VERTEX_BUFFERS);
+			BX_CHECK(_handle.idx < g_limits.maxVertexBuffers, "Invalid vertex buffer handle. %d (< %d)", _handle.idx, g_limits.maxVertexBuffers);
 			m_draw.m_startVertex  = _startVertex;
 			m_draw.m_numVertices  = _numVertices;
 			m_draw.m_vertexBuffer = _handle;
@@ -1361,21 +1909,23 @@ namespace bgfx
 		uint32_t dispatch(uint8_t _id, ProgramHandle _handle, uint16_t _ngx, uint16_t _ngy, uint16_t _ngz);
 		void sort();
 
-		bool checkAvailTransientIndexBuffer(uint32_t _num)
+		bool checkAvailTransientIndexBuffer(uint32_t _num, bool _index32)
 		{
-			uint32_t offset = m_iboffset;
-			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::uint32_min(iboffset, BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
-			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
+			const uint32_t indexSize = _index32 ? sizeof(uint32_t) : sizeof(uint16_t);
+			uint32_t offset = strideAlign(m_iboffset, indexSize);
+			uint32_t iboffset = offset + _num*indexSize;
+			iboffset = bx::uint32_min(iboffset, m_transientIb->size);
+			uint32_t num = (iboffset-offset)/indexSize;
 			return num == _num;
 		}
 
-		uint32_t allocTransientIndexBuffer(uint32_t& _num)
+		uint32_t allocTransientIndexBuffer(uint32_t& _num, bool _index32)
 		{
-			uint32_t offset = m_iboffset;
-			m_iboffset = offset + _num*sizeof(uint16_t);
-			m_iboffset = bx::uint32_min(m_iboffset, BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE);
-			_num = (m_iboffset-offset)/sizeof(uint16_t);
+			const uint32_t indexSize = _index32 ? sizeof(uint32_t) : sizeof(uint16_t);
+			uint32_t offset = strideAlign(m_iboffset, indexSize);
+			m_iboffset = offset + _num*indexSize;
+			m_iboffset = bx::uint32_min(m_iboffset, m_transientIb->size);
+			_num = (m_iboffset-offset)/indexSize;
 			return offset;
 		}
 
@@ -1383,7 +1933,7 @@ namespace bgfx
 		{
 			uint32_t offset = strideAlign(m_vboffset, _stride);
 			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::uint32_min(vboffset, BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
+			vboffset = bx::uint32_min(vboffset, m_transientVb->size);
 			uint32_t num = (vboffset-offset)/_stride;
 			return num == _num;
 		}
@@ -1392,7 +1942,7 @@ namespace bgfx
 		{
 			uint32_t offset = strideAlign(m_vboffset, _stride);
 			m_vboffset = offset + _num * _stride;
-			m_vboffset = bx::uint32_min(m_vboffset, BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE);
+			m_vboffset = bx::uint32_min(m_vboffset, m_transientVb->size);
 			_num = (m_vboffset-offset)/_stride;
 			return offset;
 		}
@@ -1466,15 +2016,17 @@ namespace bgfx
 
 		FrameBufferHandle m_fb[BGFX_CONFIG_MAX_VIEWS];
 		Clear m_clear[BGFX_CONFIG_MAX_VIEWS];
+		AttachmentHints m_hints[BGFX_CONFIG_MAX_VIEWS];
 		float m_clearColor[BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE][4];
 		Rect m_rect[BGFX_CONFIG_MAX_VIEWS];
 		Rect m_scissor[BGFX_CONFIG_MAX_VIEWS];
 		Matrix4 m_view[BGFX_CONFIG_MAX_VIEWS];
 		Matrix4 m_proj[BGFX_CONFIG_MAX_VIEWS];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		uint16_t m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS];
+		uint64_t* m_sortKeys;
+		uint16_t* m_sortValues;
+		RenderItem* m_renderItem;
+		uint16_t m_maxDrawCalls;
 		RenderDraw m_draw;
 		RenderCompute m_compute;
 		uint64_t m_flags;
@@ -1511,18 +2063,19 @@ namespace bgfx
 		uint16_t m_numFreeUniformHandles;
 		uint16_t m_numFreeWindowHandles;
 
-		IndexBufferHandle m_freeIndexBufferHandle[BGFX_CONFIG_MAX_INDEX_BUFFERS];
-		VertexDeclHandle m_freeVertexDeclHandle[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		VertexBufferHandle m_freeVertexBufferHandle[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
-		ShaderHandle m_freeShaderHandle[BGFX_CONFIG_MAX_SHADERS];
-		ProgramHandle m_freeProgramHandle[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureHandle m_freeTextureHandle[BGFX_CONFIG_MAX_TEXTURES];
-		FrameBufferHandle m_freeFrameBufferHandle[BGFX_CONFIG_MAX_FRAME_BUFFERS];
-		UniformHandle m_freeUniformHandle[BGFX_CONFIG_MAX_UNIFORMS];
+		IndexBufferHandle* m_freeIndexBufferHandle;
+		VertexDeclHandle* m_freeVertexDeclHandle;
+		VertexBufferHandle* m_freeVertexBufferHandle;
+		ShaderHandle* m_freeShaderHandle;
+		ProgramHandle* m_freeProgramHandle;
+		TextureHandle* m_freeTextureHandle;
+		FrameBufferHandle* m_freeFrameBufferHandle;
+		UniformHandle* m_freeUniformHandle;
 		TextVideoMem* m_textVideoMem;
 
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
+		int64_t m_submitTime;
 
 		bool m_discard;
 	};
@@ -1530,17 +2083,20 @@ namespace bgfx
 	struct VertexDeclRef
 	{
 		VertexDeclRef()
+			: m_vertexDeclRef(NULL)
+			, m_vertexBufferRef(NULL)
 		{
 		}
 
 		void init()
 		{
-			memset(m_vertexDeclRef, 0, sizeof(m_vertexDeclRef) );
-			memset(m_vertexBufferRef, 0xff, sizeof(m_vertexBufferRef) );
+			m_vertexDeclRef   = (uint16_t*)BX_ALLOC(g_allocator, g_limits.maxVertexDecls*sizeof(uint16_t) );
+			m_vertexBufferRef = (VertexDeclHandle*)BX_ALLOC(g_allocator, g_limits.maxVertexBuffers*sizeof(VertexDeclHandle) );
+			memset(m_vertexDeclRef, 0, g_limits.maxVertexDecls*sizeof(uint16_t) );
+			memset(m_vertexBufferRef, 0xff, g_limits.maxVertexBuffers*sizeof(VertexDeclHandle) );
 		}
 
-		template <uint16_t MaxHandlesT>
-		void shutdown(bx::HandleAllocT<MaxHandlesT>& _handleAlloc)
+		void shutdown(bx::HandleAlloc& _handleAlloc)
 		{
 			for (VertexDeclMap::iterator it = m_vertexDeclMap.begin(), itEnd = m_vertexDeclMap.end(); it != itEnd; ++it)
 			{
@@ -1548,6 +2104,11 @@ namespace bgfx
 			}
 
 			m_vertexDeclMap.clear();
+
+			BX_FREE(g_allocator, m_vertexDeclRef);
+			BX_FREE(g_allocator, m_vertexBufferRef);
+			m_vertexDeclRef   = NULL;
+			m_vertexBufferRef = NULL;
 		}
 
 		VertexDeclHandle find(uint32_t _hash)
@@ -1563,10 +2124,15 @@ namespace bgfx
 		}
 
 		void add(VertexBufferHandle _handle, VertexDeclHandle _declHandle, uint32_t _hash)
+		{
+			add(_handle, _declHandle);
+			m_vertexDeclMap.insert(stl::make_pair(_hash, _declHandle) );
+		}
+
+		void add(VertexBufferHandle _handle, VertexDeclHandle _declHandle)
 		{
 			m_vertexBufferRef[_handle.idx] = _declHandle;
 			m_vertexDeclRef[_declHandle.idx]++;
-			m_vertexDeclMap.insert(stl::make_pair(_hash, _declHandle) );
 		}
 
 		VertexDeclHandle release(VertexBufferHandle _handle)
@@ -1588,17 +2154,24 @@ namespace bgfx
 
 		typedef stl::unordered_map<uint32_t, VertexDeclHandle> VertexDeclMap;
 		VertexDeclMap m_vertexDeclMap;
-		uint16_t m_vertexDeclRef[BGFX_CONFIG_MAX_VERTEX_DECLS];
-		VertexDeclHandle m_vertexBufferRef[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		uint16_t* m_vertexDeclRef;
+		VertexDeclHandle* m_vertexBufferRef;
 	};
 
-	// First-fit non-local allocator.
+	// Non-local allocator managing sub-allocations of backing buffers.
+	// Block id (backing buffer handle) is stored in upper 32 bits of
+	// returned pointer, offset inside backing buffer in lower 32 bits.
 	class NonLocalAllocator
 	{
 	public:
 		static const uint64_t invalidBlock = UINT64_MAX;
 
 		NonLocalAllocator()
+			: m_numPending(0)
+			, m_evacuate(UINT32_MAX)
+			, m_numRelocations(0)
+			, m_released(0)
+			, m_relocated(0)
 		{
 		}
 
@@ -1610,39 +2183,22 @@ namespace bgfx
 		{
 			m_free.clear();
 			m_used.clear();
+			m_blocks.clear();
+			m_numPending = 0;
+			m_evacuate = UINT32_MAX;
 		}
 
 		void add(uint64_t _ptr, uint32_t _size)
 		{
 			m_free.push_back(Free(_ptr, _size) );
+
+			Block& block = m_blocks[uint32_t(_ptr>>32)];
+			block.m_size += _size;
 		}
 
 		uint64_t alloc(uint32_t _size)
 		{
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
-			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
-
-					m_used.insert(stl::make_pair(ptr, _size) );
-
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
-
-					return ptr;
-				}
-			}
-
-			// there is no block large enough.
-			return invalidBlock;
+			return alloc(_size, UINT32_MAX);
 		}
 
 		void free(uint64_t _block)
@@ -1650,12 +2206,46 @@ namespace bgfx
 			UsedList::iterator it = m_used.find(_block);
 			if (it != m_used.end() )
 			{
+				Block& block = m_blocks[uint32_t(it->first>>32)];
+				block.m_used -= it->second;
+				block.m_num--;
+
 				m_free.push_front(Free(it->first, it->second) );
 				m_used.erase(it);
 			}
 		}
 
-		void compact()
+		// Move sub-allocation out of block being evacuated. Caller must
+		// guarantee content of sub-allocation will be fully rewritten. Old
+		// range is freed on next trim, when frame that might still reference
+		// it is submitted.
+		uint64_t relocate(uint64_t _ptr)
+		{
+			if (uint32_t(_ptr>>32) != m_evacuate
+			||  0 == m_numRelocations
+			||  BX_COUNTOF(m_pending) == m_numPending)
+			{
+				return invalidBlock;
+			}
+
+			UsedList::const_iterator it = m_used.find(_ptr);
+			if (it == m_used.end() )
+			{
+				return invalidBlock;
+			}
+
+			uint64_t ptr = alloc(it->second, m_evacuate);
+			if (invalidBlock != ptr)
+			{
+				m_pending[m_numPending++] = _ptr;
+				m_numRelocations--;
+				m_relocated++;
+			}
+
+			return ptr;
+		}
+
+		void compact()
 		{
 			m_free.sort();
 
@@ -1674,7 +2264,151 @@ namespace bgfx
 			}
 		}
 
+		// Called once per frame. Frees ranges left behind by relocation,
+		// coalesces free list, returns blocks which stayed empty for
+		// _idleFrames (or all empty blocks when _idleFrames is 0) in
+		// _release, and picks sparsest block to evacuate next frame.
+		uint32_t trim(uint32_t _idleFrames, uint32_t _maxRelocations, uint16_t* _release, uint32_t _max)
+		{
+			for (uint32_t ii = 0, num = m_numPending; ii < num; ++ii)
+			{
+				free(m_pending[ii]);
+			}
+			m_numPending = 0;
+
+			compact();
+
+			uint32_t numRelease = 0;
+			uint64_t avail = 0;
+			for (BlockMap::iterator it = m_blocks.begin(), itEnd = m_blocks.end(); it != itEnd;)
+			{
+				Block& block = it->second;
+				block.m_idle = 0 == block.m_num ? block.m_idle+1 : 0;
+
+				if (0 == block.m_num
+				&&  block.m_idle >= _idleFrames
+				&&  numRelease < _max)
+				{
+					const uint32_t id = it->first;
+					for (FreeList::iterator fit = m_free.begin(), fitEnd = m_free.end(); fit != fitEnd;)
+					{
+						fit = uint32_t(fit->m_ptr>>32) == id ? m_free.erase(fit) : ++fit;
+					}
+
+					_release[numRelease++] = uint16_t(id);
+					BlockMap::iterator erase = it;
+					++it;
+					m_blocks.erase(erase);
+					m_released++;
+				}
+				else
+				{
+					avail += block.m_size - block.m_used;
+					++it;
+				}
+			}
+
+			// Evacuate block that is less than half full, if its content
+			// fits in free space of other blocks.
+			uint32_t evacuate = UINT32_MAX;
+			uint64_t evacuateUsed = 0;
+			uint32_t evacuateRatio = 0x8000;
+			for (BlockMap::const_iterator it = m_blocks.begin(), itEnd = m_blocks.end(); it != itEnd; ++it)
+			{
+				const Block& block = it->second;
+				const uint32_t ratio = uint32_t( (uint64_t(block.m_used)<<16)/block.m_size);
+				if (0 != block.m_num
+				&&  ratio < evacuateRatio)
+				{
+					evacuate = it->first;
+					evacuateUsed = block.m_used;
+					evacuateRatio = ratio;
+				}
+			}
+
+			const bool fits = UINT32_MAX != evacuate
+				&& avail - (m_blocks[evacuate].m_size - evacuateUsed) >= evacuateUsed
+				;
+			m_evacuate = fits ? evacuate : UINT32_MAX;
+			m_numRelocations = _maxRelocations;
+
+			return numRelease;
+		}
+
+		void getStats(BufferPoolStats& _stats) const
+		{
+			memset(&_stats, 0, sizeof(_stats) );
+
+			for (BlockMap::const_iterator it = m_blocks.begin(), itEnd = m_blocks.end(); it != itEnd; ++it)
+			{
+				_stats.size += it->second.m_size;
+				_stats.used += it->second.m_used;
+			}
+
+			for (FreeList::const_iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			{
+				_stats.largestFree = bx::uint32_max(_stats.largestFree, it->m_size);
+			}
+
+			_stats.numBuffers    = uint32_t(m_blocks.size() );
+			_stats.numAllocs     = uint32_t(m_used.size() );
+			_stats.numFreeRanges = uint32_t(m_free.size() );
+			_stats.numReleased   = m_released;
+			_stats.numRelocated  = m_relocated;
+		}
+
 	private:
+		// Best-fit by occupancy, takes free range from fullest block that
+		// can hold allocation, so that sparse blocks drain and can be
+		// released. Within block first fit is used.
+		uint64_t alloc(uint32_t _size, uint32_t _exclude)
+		{
+			FreeList::iterator best = m_free.end();
+			uint32_t bestUsed = 0;
+			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			{
+				const uint32_t id = uint32_t(it->m_ptr>>32);
+				if (it->m_size >= _size
+				&&  id != _exclude)
+				{
+					const uint32_t used = m_blocks[id].m_used;
+					if (best == m_free.end()
+					||  used > bestUsed)
+					{
+						best = it;
+						bestUsed = used;
+					}
+				}
+			}
+
+			if (best == m_free.end() )
+			{
+				// there is no block large enough.
+				return invalidBlock;
+			}
+
+			uint64_t ptr = best->m_ptr;
+
+			m_used.insert(stl::make_pair(ptr, _size) );
+
+			Block& block = m_blocks[uint32_t(ptr>>32)];
+			block.m_used += _size;
+			block.m_num++;
+			block.m_idle = 0;
+
+			if (best->m_size != _size)
+			{
+				best->m_size -= _size;
+				best->m_ptr += _size;
+			}
+			else
+			{
+				m_free.erase(best);
+			}
+
+			return ptr;
+		}
+
 		struct Free
 		{
 			Free(uint64_t _ptr, uint32_t _size)
@@ -1692,11 +2426,229 @@ namespace bgfx
 			uint32_t m_size;
 		};
 
+		struct Block
+		{
+			Block()
+				: m_size(0)
+				, m_used(0)
+				, m_num(0)
+				, m_idle(0)
+			{
+			}
+
+			uint32_t m_size;
+			uint32_t m_used;
+			uint32_t m_num;
+			uint32_t m_idle;
+		};
+
 		typedef std::list<Free> FreeList;
 		FreeList m_free;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
+
+		typedef stl::unordered_map<uint32_t, Block> BlockMap;
+		BlockMap m_blocks;
+
+		uint64_t m_pending[64];
+		uint32_t m_numPending;
+		uint32_t m_evacuate;
+		uint32_t m_numRelocations;
+		uint32_t m_released;
+		uint32_t m_relocated;
+	};
+
+	// Pool of frame buffers handed out for range of views within single
+	// frame. Views are executed in order of their ids, so requests with the
+	// same size, format and texture flags whose view ranges don't overlap
+	// alias onto the same frame buffer.
+	class TransientFrameBufferPool
+	{
+	public:
+		TransientFrameBufferPool()
+			: m_num(0)
+			, m_numRequests(0)
+			, m_lastRequests(0)
+			, m_requested(0)
+			, m_lastRequested(0)
+			, m_created(0)
+			, m_released(0)
+		{
+		}
+
+		// Takes pooled frame buffer which is free in views _first to _last.
+		// Returns invalid handle when there is none, and caller should create
+		// one and add it to pool.
+		FrameBufferHandle alloc(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint32_t _flags, uint8_t _first, uint8_t _last)
+		{
+			uint32_t views[NumViewWords];
+			viewMask(views, _first, _last);
+
+			m_numRequests++;
+
+			for (uint16_t ii = 0; ii < m_num; ++ii)
+			{
+				Entry& entry = m_entry[ii];
+				if (entry.m_width  == _width
+				&&  entry.m_height == _height
+				&&  entry.m_format == _format
+				&&  entry.m_flags  == _flags
+				&&  !overlaps(entry.m_views, views) )
+				{
+					for (uint32_t jj = 0; jj < NumViewWords; ++jj)
+					{
+						entry.m_views[jj] |= views[jj];
+					}
+
+					m_requested += entry.m_size;
+					return entry.m_handle;
+				}
+			}
+
+			FrameBufferHandle invalid = BGFX_INVALID_HANDLE;
+			return invalid;
+		}
+
+		bool add(FrameBufferHandle _handle, uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint32_t _flags, uint8_t _first, uint8_t _last, uint64_t _size)
+		{
+			if (BX_COUNTOF(m_entry) == m_num)
+			{
+				return false;
+			}
+
+			Entry& entry = m_entry[m_num++];
+			entry.m_handle = _handle;
+			entry.m_width  = _width;
+			entry.m_height = _height;
+			entry.m_format = uint8_t(_format);
+			entry.m_flags  = _flags;
+			entry.m_size   = _size;
+			entry.m_idle   = 0;
+			viewMask(entry.m_views, _first, _last);
+
+			m_requested += _size;
+			m_created++;
+			return true;
+		}
+
+		bool contains(FrameBufferHandle _handle) const
+		{
+			for (uint16_t ii = 0; ii < m_num; ++ii)
+			{
+				if (m_entry[ii].m_handle.idx == _handle.idx)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Called once per frame. Returns frame buffers which weren't used
+		// for _idleFrames frames (or all frame buffers when _idleFrames is
+		// 0) in _release, which must hold
+		// BGFX_CONFIG_MAX_TRANSIENT_FRAME_BUFFERS handles.
+		uint32_t trim(uint32_t _idleFrames, FrameBufferHandle* _release)
+		{
+			m_lastRequests  = m_numRequests;
+			m_lastRequested = m_requested;
+			m_numRequests = 0;
+			m_requested   = 0;
+
+			uint32_t numRelease = 0;
+			for (uint16_t ii = 0; ii < m_num;)
+			{
+				Entry& entry = m_entry[ii];
+
+				uint32_t used = 0;
+				for (uint32_t jj = 0; jj < NumViewWords; ++jj)
+				{
+					used |= entry.m_views[jj];
+					entry.m_views[jj] = 0;
+				}
+				entry.m_idle = 0 == used ? entry.m_idle+1 : 0;
+
+				if (entry.m_idle >= _idleFrames)
+				{
+					_release[numRelease++] = entry.m_handle;
+					entry = m_entry[--m_num];
+					m_released++;
+				}
+				else
+				{
+					++ii;
+				}
+			}
+
+			return numRelease;
+		}
+
+		void getStats(TransientFrameBufferStats& _stats) const
+		{
+			memset(&_stats, 0, sizeof(_stats) );
+
+			for (uint16_t ii = 0; ii < m_num; ++ii)
+			{
+				_stats.allocatedSize += m_entry[ii].m_size;
+			}
+
+			_stats.requestedSize   = m_lastRequested;
+			_stats.numRequests     = m_lastRequests;
+			_stats.numFrameBuffers = m_num;
+			_stats.numCreated      = m_created;
+			_stats.numReleased     = m_released;
+		}
+
+	private:
+		enum { NumViewWords = (BGFX_CONFIG_MAX_VIEWS+31)/32 };
+
+		static void viewMask(uint32_t* _views, uint32_t _first, uint32_t _last)
+		{
+			for (uint32_t ii = 0; ii < NumViewWords; ++ii)
+			{
+				const uint32_t first = bx::uint32_max(_first, ii*32);
+				const uint32_t last  = bx::uint32_min(_last, ii*32+31);
+				_views[ii] = first <= last
+					? (UINT32_MAX>>(31-(last-first) ) )<<(first-ii*32)
+					: 0
+					;
+			}
+		}
+
+		static bool overlaps(const uint32_t* _a, const uint32_t* _b)
+		{
+			for (uint32_t ii = 0; ii < NumViewWords; ++ii)
+			{
+				if (0 != (_a[ii] & _b[ii]) )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		struct Entry
+		{
+			FrameBufferHandle m_handle;
+			uint16_t m_width;
+			uint16_t m_height;
+			uint8_t m_format;
+			uint32_t m_flags;
+			uint64_t m_size;
+			uint32_t m_idle;
+			uint32_t m_views[NumViewWords];
+		};
+
+		Entry m_entry[BGFX_CONFIG_MAX_TRANSIENT_FRAME_BUFFERS];
+		uint16_t m_num;
+		uint32_t m_numRequests;
+		uint32_t m_lastRequests;
+		uint64_t m_requested;
+		uint64_t m_lastRequested;
+		uint32_t m_created;
+		uint32_t m_released;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -1705,7 +2657,7 @@ namespace bgfx
 		virtual RendererType::Enum getRendererType() const = 0;
 		virtual const char* getRendererName() const = 0;
 		virtual void flip() = 0;
-		virtual void createIndexBuffer(IndexBufferHandle _handle, Memory* _mem) = 0;
+		virtual void createIndexBuffer(IndexBufferHandle _handle, Memory* _mem, uint8_t _flags) = 0;
 		virtual void destroyIndexBuffer(IndexBufferHandle _handle) = 0;
 		virtual void createVertexDecl(VertexDeclHandle _handle, const VertexDecl& _decl) = 0;
 		virtual void destroyVertexDecl(VertexDeclHandle _handle) = 0;
@@ -1738,6 +2690,7 @@ namespace bgfx
 		virtual void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) = 0;
 		virtual void blitSetup(TextVideoMemBlitter& _blitter) = 0;
 		virtual void blitRender(TextVideoMemBlitter& _blitter, uint32_t _numIndices) = 0;
+		virtual void getStats(Stats& _stats) = 0;
 	};
 
 	inline RendererContextI::~RendererContextI()
@@ -1752,17 +2705,269 @@ namespace bgfx
 #	define BGFX_API_FUNC(_func) _func
 #endif // BGFX_CONFIG_DEBUG
 
+	struct RecordOp
+	{
+		enum Enum
+		{
+			Reset,
+			SetDebug,
+			DbgTextClear,
+			DbgTextPrint,
+			CreateIndexBuffer,
+			DestroyIndexBuffer,
+			CreateVertexBuffer,
+			DestroyVertexBuffer,
+			CreateDynamicIndexBuffer,
+			CreateDynamicIndexBufferMem,
+			UpdateDynamicIndexBuffer,
+			DestroyDynamicIndexBuffer,
+			CreateDynamicVertexBuffer,
+			CreateDynamicVertexBufferMem,
+			UpdateDynamicVertexBuffer,
+			DestroyDynamicVertexBuffer,
+			AllocTransientIndexBuffer,
+			AllocTransientVertexBuffer,
+			AllocInstanceDataBuffer,
+			CreateShader,
+			DestroyShader,
+			CreateProgram,
+			CreateComputeProgram,
+			DestroyProgram,
+			CreateTexture,
+			CreateTexture2D,
+			CreateTexture3D,
+			CreateTextureCube,
+			UpdateTexture2D,
+			UpdateTexture3D,
+			UpdateTextureCube,
+			DestroyTexture,
+			CreateFrameBuffer,
+			CreateFrameBufferWindow,
+			DestroyFrameBuffer,
+			CreateUniform,
+			DestroyUniform,
+			SetClearColor,
+			SetViewName,
+			SetViewRect,
+			SetViewScissor,
+			SetViewClear,
+			SetViewClearPalette,
+			SetViewAttachmentHints,
+			SetViewSeq,
+			SetViewFrameBuffer,
+			SetViewTransform,
+			SetMarker,
+			SetState,
+			SetStencil,
+			SetScissor,
+			SetScissorCached,
+			SetTransform,
+			AllocTransform,
+			SetTransformCached,
+			SetUniform,
+			SetIndexBuffer,
+			SetDynamicIndexBuffer,
+			SetTransientIndexBuffer,
+			SetVertexBuffer,
+			SetDynamicVertexBuffer,
+			SetTransientVertexBuffer,
+			SetInstanceDataBuffer,
+			SetProgram,
+			SetTexture,
+			SetTextureFrameBuffer,
+			Submit,
+			SetImage,
+			SetImageFrameBuffer,
+			Dispatch,
+			Discard,
+			Frame,
+
+			Count
+		};
+	};
+
+	// Serializes API calls into trace. Calls are buffered in memory and
+	// written to user writer as single chunk per frame, transient buffer
+	// contents are appended to chunk at the end of frame since they can be
+	// filled any time before bgfx::frame.
+	class Recorder : public bx::WriterI
+	{
+	public:
+		Recorder()
+			: m_writer(NULL)
+			, m_data(NULL)
+			, m_size(0)
+			, m_pos(0)
+			, m_transient(NULL)
+			, m_numTransients(0)
+			, m_maxTransients(0)
+			, m_paused(false)
+		{
+		}
+
+		virtual ~Recorder()
+		{
+		}
+
+		bool isActive() const
+		{
+			return NULL != m_writer
+				&& !m_paused
+				;
+		}
+
+		// Calls API makes internally are not part of trace, replaying
+		// outer call issues them again.
+		void pause(bool _pause)
+		{
+			m_paused = _pause;
+		}
+
+		void begin(bx::WriterI* _writer, const Resolution& _resolution, uint32_t _debug);
+		void end();
+		void frame();
+
+		Recorder& record(RecordOp::Enum _op)
+		{
+			uint8_t op = uint8_t(_op);
+			bx::write(this, op);
+			return *this;
+		}
+
+		template<typename Ty>
+		Recorder& write(const Ty& _value)
+		{
+			bx::write(this, _value);
+			return *this;
+		}
+
+		Recorder& write(const VertexDecl& _decl)
+		{
+			bgfx::write(this, _decl);
+			return *this;
+		}
+
+		Recorder& write(const Memory* _mem)
+		{
+			return writeData(_mem->data, _mem->size);
+		}
+
+		Recorder& write(const char* _str);
+		Recorder& writeVargs(const char* _format, va_list _argList);
+		Recorder& writeData(const void* _data, uint32_t _size);
+
+		// Transient buffers are referenced by allocation order in frame.
+		Recorder& writeTransient(const void* _data);
+		void addTransient(const void* _data, uint32_t _size);
+
+		virtual int32_t write(const void* _data, int32_t _size) BX_OVERRIDE;
+
+	private:
+		struct Transient
+		{
+			const void* m_data;
+			uint32_t m_size;
+		};
+
+		bx::WriterI* m_writer;
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_pos;
+		Transient* m_transient;
+		uint32_t m_numTransients;
+		uint32_t m_maxTransients;
+		bool m_paused;
+	};
+
+	struct FrameTimeHistory
+	{
+		FrameTimeHistory()
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			memset(m_time, 0, sizeof(m_time) );
+			m_pos = 0;
+		}
+
+		void push(int64_t _time)
+		{
+			m_time[m_pos%BX_COUNTOF(m_time)] = _time;
+			++m_pos;
+		}
+
+		int64_t last() const
+		{
+			return m_time[(m_pos-1)%BX_COUNTOF(m_time)];
+		}
+
+		int64_t min() const
+		{
+			const uint32_t num = bx::uint32_min(m_pos, BX_COUNTOF(m_time) );
+			int64_t result = 0 < num ? m_time[0] : 0;
+			for (uint32_t ii = 1; ii < num; ++ii)
+			{
+				result = m_time[ii] < result ? m_time[ii] : result;
+			}
+
+			return result;
+		}
+
+		int64_t max() const
+		{
+			const uint32_t num = bx::uint32_min(m_pos, BX_COUNTOF(m_time) );
+			int64_t result = 0;
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				result = m_time[ii] > result ? m_time[ii] : result;
+			}
+
+			return result;
+		}
+
+		int64_t m_time[BGFX_CONFIG_FRAME_PACING_HISTORY];
+		uint32_t m_pos;
+	};
+
+	// Render thread timings as seen by API thread.
+	struct FramePacing
+	{
+		int64_t m_renderTime;
+		int64_t m_renderTimeMax;
+		int64_t m_flipTime;
+		int64_t m_flipTimeMax;
+		int64_t m_latency;
+		int64_t m_latencyMin;
+		int64_t m_latencyMax;
+		int64_t m_waitSubmit;
+		int64_t m_renderEnd;
+		uint32_t m_renderFrames;
+	};
+
 	struct Context
 	{
 		Context()
-			: m_render(&m_frame[0])
-			, m_submit(&m_frame[1])
+			: m_render(NULL)
+			, m_submit(NULL)
+			, m_numFrames(0)
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_clearColorDirty(0)
 			, m_instBufferCount(0)
 			, m_frames(0)
 			, m_debug(BGFX_DEBUG_NONE)
+			, m_renderFrames(0)
+			, m_renderEnd(0)
+			, m_renderSubmitTime(0)
+			, m_renderWaitSubmit(0)
+			, m_submitStart(0)
+			, m_waitPacing(0)
+			, m_numDraws(0)
+			, m_numDropped(0)
 			, m_rendererInitialized(false)
 			, m_exit(false)
 		{
@@ -1776,13 +2981,15 @@ namespace bgfx
 		{
 			BX_TRACE("render thread start");
 			Context* ctx = (Context*)_userData;
+			profilerSetThreadName("Render");
 			while (!ctx->renderFrame() ) {};
+			profilerReleaseThread();
 			BX_TRACE("render thread exit");
 			return EXIT_SUCCESS;
 		}
 
 		// game thread
-		void init(RendererType::Enum _type);
+		void init(RendererType::Enum _type, uint8_t _numFrames, const Limits& _limits);
 		void shutdown();
 
 		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
@@ -1806,6 +3013,7 @@ namespace bgfx
 		BGFX_API_FUNC(void setDebug(uint32_t _debug) )
 		{
 			m_debug = _debug;
+			profilerEnable(0 != (_debug & BGFX_DEBUG_PROFILER) );
 		}
 
 		BGFX_API_FUNC(void dbgTextClear(uint8_t _attr, bool _small) )
@@ -1819,16 +3027,19 @@ namespace bgfx
 			m_submit->m_textVideoMem->printfVargs(_x, _y, _attr, _format, _argList);
 		}
 
-		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem) )
+		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem, uint8_t _flags) )
 		{
-			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
+			IndexBufferHandle handle = { m_indexBufferHandle->alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate index buffer handle.");
 			if (isValid(handle) )
 			{
+				m_indexBufferRef[handle.idx].m_flags = _flags;
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_mem);
+				cmdbuf.write(_flags);
 			}
 
 			return handle;
@@ -1847,7 +3058,7 @@ namespace bgfx
 
 			if (!isValid(declHandle) )
 			{
-				VertexDeclHandle temp = { m_vertexDeclHandle.alloc() };
+				VertexDeclHandle temp = { m_vertexDeclHandle->alloc() };
 				declHandle = temp;
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexDecl);
 				cmdbuf.write(declHandle);
@@ -1859,7 +3070,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexDecl& _decl) )
 		{
-			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
+			VertexBufferHandle handle = { m_vertexBufferHandle->alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate vertex buffer handle.");
 			if (isValid(handle) )
@@ -1892,17 +3103,18 @@ namespace bgfx
 				cmdbuf.write(declHandle);
 			}
 
-			m_vertexBufferHandle.free(_handle.idx);
+			m_vertexBufferHandle->free(_handle.idx);
 		}
 
-		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num) )
+		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint8_t _flags) )
 		{
 			DynamicIndexBufferHandle handle = BGFX_INVALID_HANDLE;
-			uint32_t size = BX_ALIGN_16(_num*2);
+			const uint32_t indexSize = 0 != (_flags & BGFX_BUFFER_INDEX32) ? sizeof(uint32_t) : sizeof(uint16_t);
+			uint32_t size = BX_ALIGN_16(_num*indexSize);
 			uint64_t ptr = m_dynamicIndexBufferAllocator.alloc(size);
 			if (ptr == NonLocalAllocator::invalidBlock)
 			{
-				IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
+				IndexBufferHandle indexBufferHandle = { m_indexBufferHandle->alloc() };
 				BX_WARN(isValid(indexBufferHandle), "Failed to allocate index buffer handle.");
 				if (!isValid(indexBufferHandle) )
 				{
@@ -1917,7 +3129,7 @@ namespace bgfx
 				ptr = m_dynamicIndexBufferAllocator.alloc(size);
 			}
 
-			handle.idx = m_dynamicIndexBufferHandle.alloc();
+			handle.idx = m_dynamicIndexBufferHandle->alloc();
 			BX_WARN(isValid(handle), "Failed to allocate dynamic index buffer handle.");
 			if (!isValid(handle) )
 			{
@@ -1928,27 +3140,56 @@ namespace bgfx
 			dib.m_handle.idx = uint16_t(ptr>>32);
 			dib.m_offset = uint32_t(ptr);
 			dib.m_size = size;
+			dib.m_startIndex = dib.m_offset/indexSize;
+			dib.m_numIndices = _num;
+			dib.m_drawFrame = UINT32_MAX;
+			dib.m_flags = _flags;
 
 			return handle;
 		}
 
-		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem) )
+		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint8_t _flags) )
 		{
-			DynamicIndexBufferHandle handle = createDynamicIndexBuffer(_mem->size/2);
+			const uint32_t indexSize = 0 != (_flags & BGFX_BUFFER_INDEX32) ? sizeof(uint32_t) : sizeof(uint16_t);
+			DynamicIndexBufferHandle handle = createDynamicIndexBuffer(_mem->size/indexSize, _flags);
 			if (isValid(handle) )
 			{
-				updateDynamicIndexBuffer(handle, _mem);
+				updateDynamicIndexBuffer(handle, 0, _mem);
 			}
 			return handle;
 		}
 
-		BGFX_API_FUNC(void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, const Memory* _mem) )
+		BGFX_API_FUNC(void updateDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem) )
 		{
 			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
+			const uint32_t indexSize = 0 != (dib.m_flags & BGFX_BUFFER_INDEX32) ? sizeof(uint32_t) : sizeof(uint16_t);
+			const uint32_t offset = bx::uint32_min(_startIndex*indexSize, dib.m_size);
+			BX_WARN(offset + _mem->size <= dib.m_size, "Truncating dynamic index buffer update (start %d, size %d, buffer size %d)."
+				, _startIndex
+				, _mem->size
+				, dib.m_size
+				);
+
+			if (0 == offset
+			&&  _mem->size >= dib.m_numIndices*indexSize
+			&&  m_frames != dib.m_drawFrame)
+			{
+				// Whole content is replaced, move it out of sparse backing buffer.
+				// Not after draw in this frame referenced it, draw would keep
+				// stale content of old range.
+				uint64_t ptr = m_dynamicIndexBufferAllocator.relocate(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
+				if (ptr != NonLocalAllocator::invalidBlock)
+				{
+					dib.m_handle.idx = uint16_t(ptr>>32);
+					dib.m_offset = uint32_t(ptr);
+					dib.m_startIndex = dib.m_offset/indexSize;
+				}
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
 			cmdbuf.write(dib.m_handle);
-			cmdbuf.write(dib.m_offset);
-			cmdbuf.write(dib.m_size);
+			cmdbuf.write(dib.m_offset + offset);
+			cmdbuf.write(dib.m_size - offset);
 			cmdbuf.write(_mem);
 		}
 
@@ -1961,7 +3202,7 @@ namespace bgfx
 		{
 			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
 			m_dynamicIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
-			m_dynamicIndexBufferHandle.free(_handle.idx);
+			m_dynamicIndexBufferHandle->free(_handle.idx);
 		}
 
 		BGFX_API_FUNC(DynamicVertexBufferHandle createDynamicVertexBuffer(uint16_t _num, const VertexDecl& _decl) )
@@ -1971,7 +3212,7 @@ namespace bgfx
 			uint64_t ptr = m_dynamicVertexBufferAllocator.alloc(size);
 			if (ptr == NonLocalAllocator::invalidBlock)
 			{
-				VertexBufferHandle vertexBufferHandle = { m_vertexBufferHandle.alloc() };
+				VertexBufferHandle vertexBufferHandle = { m_vertexBufferHandle->alloc() };
 
 				BX_WARN(isValid(handle), "Failed to allocate dynamic vertex buffer handle.");
 				if (!isValid(vertexBufferHandle) )
@@ -1989,13 +3230,15 @@ namespace bgfx
 
 			VertexDeclHandle declHandle = findVertexDecl(_decl);
 
-			handle.idx = m_dynamicVertexBufferHandle.alloc();
+			handle.idx = m_dynamicVertexBufferHandle->alloc();
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[handle.idx];
 			dvb.m_handle.idx = uint16_t(ptr>>32);
 			dvb.m_offset = uint32_t(ptr);
 			dvb.m_size = size;
 			dvb.m_startVertex = dvb.m_offset/_decl.m_stride;
-			dvb.m_numVertices = dvb.m_size/_decl.m_stride;
+			dvb.m_numVertices = _num;
+			dvb.m_stride = _decl.m_stride;
+			dvb.m_drawFrame = UINT32_MAX;
 			dvb.m_decl = declHandle;
 			m_declRef.add(dvb.m_handle, declHandle, _decl.m_hash);
 
@@ -2009,18 +3252,50 @@ namespace bgfx
 			DynamicVertexBufferHandle handle = createDynamicVertexBuffer(uint16_t(numVertices), _decl);
 			if (isValid(handle) )
 			{
-				updateDynamicVertexBuffer(handle, _mem);
+				updateDynamicVertexBuffer(handle, 0, _mem);
 			}
 			return handle;
 		}
 
-		BGFX_API_FUNC(void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, const Memory* _mem) )
+		BGFX_API_FUNC(void updateDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem) )
 		{
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
+			const uint32_t offset = bx::uint32_min(_startVertex*dvb.m_stride, dvb.m_size);
+			BX_WARN(offset + _mem->size <= dvb.m_size, "Truncating dynamic vertex buffer update (start %d, size %d, buffer size %d)."
+				, _startVertex
+				, _mem->size
+				, dvb.m_size
+				);
+
+			if (0 == offset
+			&&  _mem->size >= dvb.m_numVertices*dvb.m_stride
+			&&  m_frames != dvb.m_drawFrame)
+			{
+				// Whole content is replaced, move it out of sparse backing buffer.
+				// Not after draw in this frame referenced it, draw would keep
+				// stale content of old range.
+				uint64_t ptr = m_dynamicVertexBufferAllocator.relocate(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
+				if (ptr != NonLocalAllocator::invalidBlock)
+				{
+					VertexBufferHandle handle = { uint16_t(ptr>>32) };
+					m_declRef.add(handle, dvb.m_decl);
+					VertexDeclHandle declHandle = m_declRef.release(dvb.m_handle);
+					if (isValid(declHandle) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexDecl);
+						cmdbuf.write(declHandle);
+					}
+
+					dvb.m_handle = handle;
+					dvb.m_offset = uint32_t(ptr);
+					dvb.m_startVertex = dvb.m_offset/dvb.m_stride;
+				}
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
 			cmdbuf.write(dvb.m_handle);
-			cmdbuf.write(dvb.m_offset);
-			cmdbuf.write(dvb.m_size);
+			cmdbuf.write(dvb.m_offset + offset);
+			cmdbuf.write(dvb.m_size - offset);
 			cmdbuf.write(_mem);
 		}
 
@@ -2041,12 +3316,30 @@ namespace bgfx
 			}
 
 			m_dynamicVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
-			m_dynamicVertexBufferHandle.free(_handle.idx);
+			m_dynamicVertexBufferHandle->free(_handle.idx);
+		}
+
+		BGFX_API_FUNC(void getBufferPoolStats(BufferPoolStats& _indexPool, BufferPoolStats& _vertexPool) )
+		{
+			m_dynamicIndexBufferAllocator.getStats(_indexPool);
+			m_dynamicVertexBufferAllocator.getStats(_vertexPool);
+		}
+
+		BGFX_API_FUNC(void getTransientFrameBufferStats(TransientFrameBufferStats& _stats) )
+		{
+			m_transientFrameBufferPool.getStats(_stats);
+		}
+
+		BGFX_API_FUNC(bool isTransientFrameBuffer(FrameBufferHandle _handle) const)
+		{
+			return m_transientFrameBufferPool.contains(_handle);
 		}
 
-		BGFX_API_FUNC(bool checkAvailTransientIndexBuffer(uint32_t _num) const)
+		BGFX_API_FUNC(FrameBufferHandle allocTransientFrameBuffer(uint16_t _width, uint16_t _height, TextureFormat::Enum _format, uint8_t _firstView, uint8_t _lastView, uint32_t _textureFlags) );
+
+		BGFX_API_FUNC(bool checkAvailTransientIndexBuffer(uint32_t _num, bool _index32) const)
 		{
-			return m_submit->checkAvailTransientIndexBuffer(_num);
+			return m_submit->checkAvailTransientIndexBuffer(_num, _index32);
 		}
 
 		BGFX_API_FUNC(bool checkAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride) const)
@@ -2058,7 +3351,7 @@ namespace bgfx
 		{
 			TransientIndexBuffer* ib = NULL;
 
-			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
+			IndexBufferHandle handle = { m_indexBufferHandle->alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate transient index buffer handle.");
 			if (isValid(handle) )
 			{
@@ -2070,6 +3363,8 @@ namespace bgfx
 				ib->data = (uint8_t*)&ib[1];
 				ib->size = _size;
 				ib->handle = handle;
+				ib->startIndex = 0;
+				ib->index32 = false;
 			}
 
 			return ib;
@@ -2084,23 +3379,25 @@ namespace bgfx
 			BX_FREE(g_allocator, const_cast<TransientIndexBuffer*>(_ib) );
 		}
 
-		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num) )
+		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32) )
 		{
-			uint32_t offset = m_submit->allocTransientIndexBuffer(_num);
+			uint32_t offset = m_submit->allocTransientIndexBuffer(_num, _index32);
 
 			TransientIndexBuffer& dib = *m_submit->m_transientIb;
+			const uint32_t indexSize = _index32 ? sizeof(uint32_t) : sizeof(uint16_t);
 
 			_tib->data = &dib.data[offset];
-			_tib->size = _num * sizeof(uint16_t);
+			_tib->size = _num * indexSize;
 			_tib->handle = dib.handle;
-			_tib->startIndex = offset/sizeof(uint16_t);
+			_tib->startIndex = offset/indexSize;
+			_tib->index32 = _index32;
 		}
 
 		TransientVertexBuffer* createTransientVertexBuffer(uint32_t _size, const VertexDecl* _decl = NULL)
 		{
 			TransientVertexBuffer* vb = NULL;
 
-			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
+			VertexBufferHandle handle = { m_vertexBufferHandle->alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate transient vertex buffer handle.");
 			if (isValid(handle) )
@@ -2149,7 +3446,7 @@ namespace bgfx
 
 			if (!isValid(declHandle) )
 			{
-				VertexDeclHandle temp = { m_vertexDeclHandle.alloc() };
+				VertexDeclHandle temp = { m_vertexDeclHandle->alloc() };
 				declHandle = temp;
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexDecl);
 				cmdbuf.write(declHandle);
@@ -2202,7 +3499,7 @@ namespace bgfx
 				return invalid;
 			}
 
-			ShaderHandle handle = { m_shaderHandle.alloc() };
+			ShaderHandle handle = { m_shaderHandle->alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate shader handle.");
 			if (isValid(handle) )
@@ -2243,10 +3540,11 @@ namespace bgfx
 					uint16_t regCount;
 					bx::read(&reader, regCount);
 
-					PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
+					const uint32_t hash = hashName(name, nameSize);
+					PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name, nameSize, hash);
 					if (PredefinedUniform::Count == predefined)
 					{
-						uniforms[sr.m_num] = createUniform(name, UniformType::Enum(type), regCount);
+						uniforms[sr.m_num] = createUniform(name, nameSize, hash, UniformType::Enum(type), regCount);
 						sr.m_num++;
 					}
 				}
@@ -2344,7 +3642,7 @@ namespace bgfx
 			}
 
 			ProgramHandle handle;
- 			handle.idx = m_programHandle.alloc();
+ 			handle.idx = m_programHandle->alloc();
 
 			BX_WARN(isValid(handle), "Failed to allocate program handle.");
 			if (isValid(handle) )
@@ -2373,7 +3671,7 @@ namespace bgfx
 			}
 
 			ProgramHandle handle;
-			handle.idx = m_programHandle.alloc();
+			handle.idx = m_programHandle->alloc();
 
 			BX_WARN(isValid(handle), "Failed to allocate program handle.");
 			if (isValid(handle) )
@@ -2429,13 +3727,18 @@ namespace bgfx
 				}
 			}
 
-			TextureHandle handle = { m_textureHandle.alloc() };
+			TextureHandle handle = { m_textureHandle->alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate texture handle.");
 			if (isValid(handle) )
 			{
 				TextureRef& ref = m_textureRef[handle.idx];
 				ref.m_refCount = 1;
 
+				if (0 != (_flags & BGFX_TEXTURE_COMPRESS_MASK) )
+				{
+					compressTextureAsync(_mem, _flags);
+				}
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
 				cmdbuf.write(handle);
 				cmdbuf.write(_mem);
@@ -2495,7 +3798,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(FrameBufferHandle createFrameBuffer(uint8_t _num, TextureHandle* _handles) )
 		{
-			FrameBufferHandle handle = { m_frameBufferHandle.alloc() };
+			FrameBufferHandle handle = { m_frameBufferHandle->alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate frame buffer handle.");
 
 			if (isValid(handle) )
@@ -2524,7 +3827,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(FrameBufferHandle createFrameBuffer(void* _nwh, uint16_t _width, uint16_t _height, TextureFormat::Enum _depthFormat) )
 		{
-			FrameBufferHandle handle = { m_frameBufferHandle.alloc() };
+			FrameBufferHandle handle = { m_frameBufferHandle->alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate frame buffer handle.");
 
 			if (isValid(handle) )
@@ -2567,17 +3870,26 @@ namespace bgfx
 
 		BGFX_API_FUNC(UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num) )
 		{
-			BX_WARN(PredefinedUniform::Count == nameToPredefinedUniformEnum(_name), "%s is predefined uniform name.", _name);
-			if (PredefinedUniform::Count != nameToPredefinedUniformEnum(_name) )
+			const uint32_t len  = (uint32_t)strlen(_name);
+			const uint32_t hash = hashName(_name, len);
+
+			BX_WARN(PredefinedUniform::Count == nameToPredefinedUniformEnum(_name, len, hash), "%s is predefined uniform name.", _name);
+			if (PredefinedUniform::Count != nameToPredefinedUniformEnum(_name, len, hash) )
 			{
 				UniformHandle handle = BGFX_INVALID_HANDLE;
 				return handle;
 			}
 
-			UniformHashMap::iterator it = m_uniformHashMap.find(_name);
-			if (it != m_uniformHashMap.end() )
+			return createUniform(_name, len, hash, _type, _num);
+		}
+
+		UniformHandle createUniform(const char* _name, uint32_t _len, uint32_t _hash, UniformType::Enum _type, uint16_t _num)
+		{
+			uint32_t nameIdx = m_uniformNames.find(_name, _len, _hash);
+			if (UINT32_MAX != nameIdx
+			&&  isValid(m_uniformNames.getValue(nameIdx) ) )
 			{
-				UniformHandle handle = it->second;
+				UniformHandle handle = m_uniformNames.getValue(nameIdx);
 				UniformRef& uniform = m_uniformRef[handle.idx];
 
 				uint32_t oldsize = g_uniformTypeSize[uniform.m_type];
@@ -2593,16 +3905,16 @@ namespace bgfx
 					cmdbuf.write(handle);
 					cmdbuf.write(uniform.m_type);
 					cmdbuf.write(uniform.m_num);
-					uint8_t len = (uint8_t)strlen(_name)+1;
+					uint8_t len = (uint8_t)(_len+1);
 					cmdbuf.write(len);
-					cmdbuf.write(_name, len);
+					cmdbuf.write(m_uniformNames.getName(nameIdx), len);
 				}
 
 				++uniform.m_refCount;
 				return handle;
 			}
 
-			UniformHandle handle = { m_uniformHandle.alloc() };
+			UniformHandle handle = { m_uniformHandle->alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate uniform handle.");
 			if (isValid(handle) )
@@ -2613,16 +3925,15 @@ namespace bgfx
 				uniform.m_refCount = 1;
 				uniform.m_type = _type;
 				uniform.m_num  = _num;
-
-				m_uniformHashMap.insert(stl::make_pair(stl::string(_name), handle) );
+				uniform.m_name = m_uniformNames.add(_name, _len, _hash, handle);
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniform);
 				cmdbuf.write(handle);
 				cmdbuf.write(_type);
 				cmdbuf.write(_num);
-				uint8_t len = (uint8_t)strlen(_name)+1;
+				uint8_t len = (uint8_t)(_len+1);
 				cmdbuf.write(len);
-				cmdbuf.write(_name, len);
+				cmdbuf.write(m_uniformNames.getName(uniform.m_name), len);
 			}
 
 			return handle;
@@ -2636,6 +3947,8 @@ namespace bgfx
 
 			if (0 == refs)
 			{
+				m_uniformNames.getValue(uniform.m_name).idx = invalidHandle;
+
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyUniform);
 				cmdbuf.write(_handle);
 				m_submit->free(_handle);
@@ -2657,7 +3970,7 @@ namespace bgfx
 				, BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE
 				);
 			memcpy(&m_clearColor[_index][0], _rgba, 16);
-			m_clearColorDirty = 2;
+			m_clearColorDirty = m_numFrames;
 		}
 
 		BGFX_API_FUNC(void setViewName(uint8_t _id, const char* _name) )
@@ -2717,6 +4030,13 @@ namespace bgfx
 			clear.m_stencil  = _stencil;
 		}
 
+		BGFX_API_FUNC(void setViewAttachmentHints(uint8_t _id, uint8_t _dontCare, uint8_t _discard) )
+		{
+			AttachmentHints& hints = m_hints[_id];
+			hints.m_dontCare = _dontCare;
+			hints.m_discard  = _discard;
+		}
+
 		BGFX_API_FUNC(void setViewSeq(uint8_t _id, bool _enabled) )
 		{
 			m_seqMask[_id] = _enabled ? 0xffff : 0x0;
@@ -2797,12 +4117,18 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices) )
 		{
-			m_submit->setIndexBuffer(_handle, _firstIndex, _numIndices);
+			// Invalid handle draws without indices.
+			const bool index32 = isValid(_handle) && 0 != (m_indexBufferRef[_handle.idx].m_flags & BGFX_BUFFER_INDEX32);
+			m_submit->setIndexBuffer(_handle, _firstIndex, _numIndices, index32);
 		}
 
 		BGFX_API_FUNC(void setIndexBuffer(DynamicIndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices) )
 		{
-			m_submit->setIndexBuffer(m_dynamicIndexBuffers[_handle.idx].m_handle, _firstIndex, _numIndices);
+			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
+			dib.m_drawFrame = m_frames;
+			const bool index32 = 0 != (dib.m_flags & BGFX_BUFFER_INDEX32);
+			const uint32_t numIndices = bx::uint32_min(_numIndices, dib.m_numIndices);
+			m_submit->setIndexBuffer(dib.m_handle, dib.m_startIndex + _firstIndex, numIndices, index32);
 		}
 
 		BGFX_API_FUNC(void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices) )
@@ -2817,7 +4143,9 @@ namespace bgfx
 
 		BGFX_API_FUNC(void setVertexBuffer(DynamicVertexBufferHandle _handle, uint32_t _numVertices) )
 		{
-			m_submit->setVertexBuffer(m_dynamicVertexBuffers[_handle.idx], _numVertices);
+			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
+			dvb.m_drawFrame = m_frames;
+			m_submit->setVertexBuffer(dvb, _numVertices);
 		}
 
 		BGFX_API_FUNC(void setVertexBuffer(const TransientVertexBuffer* _tvb, uint32_t _startVertex, uint32_t _numVertices) )
@@ -2894,15 +4222,39 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint32_t frame() );
 
+		BGFX_API_FUNC(const Stats* getStats() );
+		BGFX_API_FUNC(void waitFrameStart() );
+
 		void dumpViewStats();
 		void freeDynamicBuffers();
+		void trimDynamicBuffers(uint32_t _idleFrames);
+		void trimTransientFrameBuffers(uint32_t _idleFrames);
 		void freeAllHandles(Frame* _frame);
+		void createHandleTables();
+		void destroyHandleTables();
 		void frameNoRenderWait();
 		void swap();
+		void compressTextureAsync(const Memory* _mem, uint32_t _flags);
+		void readPacing(FramePacing& _pacing) const;
+
+		Frame* nextFrame(const Frame* _frame)
+		{
+			for (uint8_t ii = 0, num = m_numFrames-1; ii < num; ++ii)
+			{
+				if (_frame == m_frame[ii])
+				{
+					return m_frame[ii+1];
+				}
+			}
+
+			return m_frame[0];
+		}
 
 		// render thread
 		bool renderFrame();
+		void publishPacing();
 		void flushTextureUpdateBatch(CommandBuffer& _cmdbuf);
+		void flushBufferUpdateBatch(CommandBuffer& _cmdbuf);
 		void rendererExecCommands(CommandBuffer& _cmdbuf);
 
 #if BGFX_CONFIG_MULTITHREADED
@@ -2913,9 +4265,11 @@ namespace bgfx
 
 		void gameSemWait()
 		{
+			BGFX_PROFILER_SCOPE("waitSubmit");
 			int64_t start = bx::getHPCounter();
 			bool ok = m_gameSem.wait();
 			BX_CHECK(ok, "Semaphore wait failed."); BX_UNUSED(ok);
+			m_render = nextFrame(m_render);
 			m_render->m_waitSubmit = bx::getHPCounter()-start;
 		}
 
@@ -2926,6 +4280,7 @@ namespace bgfx
 
 		void renderSemWait()
 		{
+			BGFX_PROFILER_SCOPE("waitRender");
 			int64_t start = bx::getHPCounter();
 			bool ok = m_renderSem.wait();
 			BX_CHECK(ok, "Semaphore wait failed."); BX_UNUSED(ok);
@@ -2942,6 +4297,7 @@ namespace bgfx
 
 		void gameSemWait()
 		{
+			m_render = nextFrame(m_render);
 		}
 
 		void renderSemPost()
@@ -2953,35 +4309,43 @@ namespace bgfx
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
-		Frame m_frame[2];
+		// Frames form a ring, API thread submits into m_submit and render
+		// thread follows one or more frames behind in same order.
+		Frame* m_frame[BGFX_CONFIG_MAX_FRAMES];
 		Frame* m_render;
 		Frame* m_submit;
+		uint8_t m_numFrames;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		uint16_t m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		uint64_t* m_tempKeys;
+		uint16_t* m_tempValues;
 
-		DynamicIndexBuffer m_dynamicIndexBuffers[BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS];
-		DynamicVertexBuffer m_dynamicVertexBuffers[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
+		// Handle allocators and handle indexed tables are sized from
+		// g_limits, see createHandleTables.
+		DynamicIndexBuffer* m_dynamicIndexBuffers;
+		DynamicVertexBuffer* m_dynamicVertexBuffers;
 
 		uint16_t m_numFreeDynamicIndexBufferHandles;
 		uint16_t m_numFreeDynamicVertexBufferHandles;
-		DynamicIndexBufferHandle m_freeDynamicIndexBufferHandle[BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS];
-		DynamicVertexBufferHandle m_freeDynamicVertexBufferHandle[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
+		DynamicIndexBufferHandle* m_freeDynamicIndexBufferHandle;
+		DynamicVertexBufferHandle* m_freeDynamicVertexBufferHandle;
 
 		NonLocalAllocator m_dynamicIndexBufferAllocator;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS> m_dynamicIndexBufferHandle;
+		bx::HandleAlloc* m_dynamicIndexBufferHandle;
 		NonLocalAllocator m_dynamicVertexBufferAllocator;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS> m_dynamicVertexBufferHandle;
+		bx::HandleAlloc* m_dynamicVertexBufferHandle;
+
+		TransientFrameBufferPool m_transientFrameBufferPool;
+		bx::JobCounter m_compressCounter;
 
-		bx::HandleAllocT<BGFX_CONFIG_MAX_INDEX_BUFFERS> m_indexBufferHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_DECLS > m_vertexDeclHandle;
+		bx::HandleAlloc* m_indexBufferHandle;
+		bx::HandleAlloc* m_vertexDeclHandle;
 
-		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_BUFFERS> m_vertexBufferHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_SHADERS> m_shaderHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_PROGRAMS> m_programHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_TEXTURES> m_textureHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
-		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
+		bx::HandleAlloc* m_vertexBufferHandle;
+		bx::HandleAlloc* m_shaderHandle;
+		bx::HandleAlloc* m_programHandle;
+		bx::HandleAlloc* m_textureHandle;
+		bx::HandleAlloc* m_frameBufferHandle;
+		bx::HandleAlloc* m_uniformHandle;
 
 		struct ShaderRef
 		{
@@ -3000,6 +4364,7 @@ namespace bgfx
 		struct UniformRef
 		{
 			UniformType::Enum m_type;
+			uint32_t m_name;
 			uint16_t m_num;
 			int16_t m_refCount;
 		};
@@ -3009,6 +4374,11 @@ namespace bgfx
 			int16_t m_refCount;
 		};
 
+		struct IndexBufferRef
+		{
+			uint8_t m_flags;
+		};
+
 		struct FrameBufferRef
 		{
 			union un
@@ -3019,17 +4389,18 @@ namespace bgfx
 			bool m_window;
 		};
 
-		typedef stl::unordered_map<stl::string, UniformHandle> UniformHashMap;
-		UniformHashMap m_uniformHashMap;
-		UniformRef m_uniformRef[BGFX_CONFIG_MAX_UNIFORMS];
-		ShaderRef m_shaderRef[BGFX_CONFIG_MAX_SHADERS];
-		ProgramRef m_programRef[BGFX_CONFIG_MAX_PROGRAMS];
-		TextureRef m_textureRef[BGFX_CONFIG_MAX_TEXTURES];
-		FrameBufferRef m_frameBufferRef[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		NameHashMap<UniformHandle> m_uniformNames;
+		UniformRef* m_uniformRef;
+		ShaderRef* m_shaderRef;
+		ProgramRef* m_programRef;
+		TextureRef* m_textureRef;
+		FrameBufferRef* m_frameBufferRef;
+		IndexBufferRef* m_indexBufferRef;
 		VertexDeclRef m_declRef;
 
 		FrameBufferHandle m_fb[BGFX_CONFIG_MAX_VIEWS];
 		Clear m_clear[BGFX_CONFIG_MAX_VIEWS];
+		AttachmentHints m_hints[BGFX_CONFIG_MAX_VIEWS];
 
 		float m_clearColor[BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE][4];
 		Rect m_rect[BGFX_CONFIG_MAX_VIEWS];
@@ -3046,10 +4417,35 @@ namespace bgfx
 		uint32_t m_frames;
 		uint32_t m_debug;
 
+		// Frame pacing, render thread side.
+		uint32_t m_renderFrames;
+		int64_t m_renderEnd;
+		int64_t m_renderSubmitTime;
+		int64_t m_renderWaitSubmit;
+		FrameTimeHistory m_renderTime;
+		FrameTimeHistory m_flipTime;
+		FrameTimeHistory m_latency;
+
+		// Snapshot of render thread side, API thread reads it only
+		// through readPacing.
+		mutable bx::LwMutex m_pacingMutex;
+		FramePacing m_pacing;
+		Stats m_rendererStats;
+
+		// Frame pacing, API thread side.
+		int64_t m_frameSubmitTime[BGFX_CONFIG_MAX_FRAMES];
+		int64_t m_submitStart;
+		int64_t m_waitPacing;
+		FrameTimeHistory m_submitTime;
+		uint32_t m_numDraws;
+		uint32_t m_numDropped;
+		Stats m_stats;
+
 		TextVideoMemBlitter m_textVideoMemBlitter;
 		ClearQuad m_clearQuad;
 
 		RendererContextI* m_renderCtx;
+		Recorder m_recorder;
 
 		bool m_rendererInitialized;
 		bool m_exit;
@@ -3057,6 +4453,9 @@ namespace bgfx
 		BX_CACHE_LINE_ALIGN_MARKER();
 		typedef UpdateBatchT<256> TextureUpdateBatch;
 		TextureUpdateBatch m_textureUpdateBatch;
+
+		typedef UpdateBatchT<256> BufferUpdateBatch;
+		BufferUpdateBatch m_bufferUpdateBatch;
 	};
 
 #undef BGFX_API_FUNC
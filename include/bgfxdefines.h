@@ -185,12 +185,19 @@
 #define BGFX_CLEAR_DEPTH_BIT             UINT8_C(0x02)
 #define BGFX_CLEAR_STENCIL_BIT           UINT8_C(0x04)
 
+///
+#define BGFX_ATTACHMENT_NONE             UINT8_C(0x00)
+#define BGFX_ATTACHMENT_COLOR_BIT        UINT8_C(0x01)
+#define BGFX_ATTACHMENT_DEPTH_BIT        UINT8_C(0x02)
+#define BGFX_ATTACHMENT_STENCIL_BIT      UINT8_C(0x04)
+
 ///
 #define BGFX_DEBUG_NONE                  UINT32_C(0x00000000)
 #define BGFX_DEBUG_WIREFRAME             UINT32_C(0x00000001)
 #define BGFX_DEBUG_IFH                   UINT32_C(0x00000002)
 #define BGFX_DEBUG_STATS                 UINT32_C(0x00000004)
 #define BGFX_DEBUG_TEXT                  UINT32_C(0x00000008)
+#define BGFX_DEBUG_PROFILER              UINT32_C(0x00000010)
 
 ///
 #define BGFX_TEXTURE_NONE                UINT32_C(0x00000000)
@@ -237,6 +244,11 @@
 #define BGFX_TEXTURE_COMPARE_SHIFT       16
 #define BGFX_TEXTURE_COMPARE_MASK        UINT32_C(0x000f0000)
 #define BGFX_TEXTURE_COMPUTE_WRITE       UINT32_C(0x00100000)
+#define BGFX_TEXTURE_COMPRESS_BC1        UINT32_C(0x00200000)
+#define BGFX_TEXTURE_COMPRESS_BC3        UINT32_C(0x00400000)
+#define BGFX_TEXTURE_COMPRESS_ETC1       UINT32_C(0x00600000)
+#define BGFX_TEXTURE_COMPRESS_SHIFT      21
+#define BGFX_TEXTURE_COMPRESS_MASK       UINT32_C(0x00600000)
 #define BGFX_TEXTURE_RESERVED_SHIFT      24
 #define BGFX_TEXTURE_RESERVED_MASK       UINT32_C(0xff000000)
 
@@ -264,6 +276,19 @@
 #define BGFX_RESET_VSYNC                 UINT32_C(0x00000080)
 #define BGFX_RESET_CAPTURE               UINT32_C(0x00000100)
 
+///
+#define BGFX_MIPS_NONE                   UINT32_C(0x00000000)
+#define BGFX_MIPS_FILTER_BOX             UINT32_C(0x00000000)
+#define BGFX_MIPS_FILTER_KAISER          UINT32_C(0x00000001)
+#define BGFX_MIPS_FILTER_SHIFT           0
+#define BGFX_MIPS_FILTER_MASK            UINT32_C(0x00000001)
+#define BGFX_MIPS_SRGB                   UINT32_C(0x00000002)
+#define BGFX_MIPS_ALPHA_COVERAGE         UINT32_C(0x00000004)
+
+///
+#define BGFX_BUFFER_NONE                 UINT8_C(0x00)
+#define BGFX_BUFFER_INDEX32              UINT8_C(0x01)
+
 ///
 #define BGFX_CAPS_TEXTURE_COMPARE_LEQUAL UINT64_C(0x0000000000000001)
 #define BGFX_CAPS_TEXTURE_COMPARE_ALL    UINT64_C(0x0000000000000003)
@@ -276,5 +301,6 @@
 #define BGFX_CAPS_COMPUTE                UINT64_C(0x0000000000000100)
 #define BGFX_CAPS_FRAGMENT_ORDERING      UINT64_C(0x0000000000000200)
 #define BGFX_CAPS_SWAP_CHAIN             UINT64_C(0x0000000000000400)
+#define BGFX_CAPS_INDEX32                UINT64_C(0x0000000000000800)
 
 #endif // BGFX_DEFINES_H_HEADER_GUARD
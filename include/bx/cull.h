@@ -0,0 +1,221 @@
+/*
+ * Copyright 2010-2014 Branimir Karadzic. All rights reserved.
+ * License: http://www.opensource.org/licenses/BSD-2-Clause
+ */
+
+#ifndef BX_CULL_H_HEADER_GUARD
+#define BX_CULL_H_HEADER_GUARD
+
+#include <math.h> // sqrtf
+#include "float4_t.h"
+#include "uint32_t.h"
+
+namespace bx
+{
+	/// Extracts view frustum planes from view-projection matrix, in order
+	/// left, right, bottom, top, near and far. Each plane is (a, b, c, d)
+	/// with normalized normal pointing inside of frustum.
+	///
+	/// Matrix is in the same layout as ones built by mtxProj and mtxMul.
+	/// _oglNdc must match the one used to build projection matrix.
+	inline void frustumPlanes(float _planes[24], const float* _viewProj, bool _oglNdc = false)
+	{
+		const float* mtx = _viewProj;
+
+		for (uint32_t ii = 0; ii < 4; ++ii)
+		{
+			const float col0 = mtx[ii*4+0];
+			const float col1 = mtx[ii*4+1];
+			const float col2 = mtx[ii*4+2];
+			const float col3 = mtx[ii*4+3];
+
+			_planes[ 0+ii] = col3 + col0;
+			_planes[ 4+ii] = col3 - col0;
+			_planes[ 8+ii] = col3 + col1;
+			_planes[12+ii] = col3 - col1;
+			_planes[16+ii] = _oglNdc ? col3 + col2 : col2;
+			_planes[20+ii] = col3 - col2;
+		}
+
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			float* plane = &_planes[ii*4];
+			const float len = sqrtf(plane[0]*plane[0] + plane[1]*plane[1] + plane[2]*plane[2]);
+			const float invLen = 0.0f < len ? 1.0f/len : 0.0f;
+			plane[0] *= invLen;
+			plane[1] *= invLen;
+			plane[2] *= invLen;
+			plane[3] *= invLen;
+		}
+	}
+
+	/// Frustum planes splatted across lanes, shared by culling kernels.
+	struct CullPlanes
+	{
+		float4_t nx[6];
+		float4_t ny[6];
+		float4_t nz[6];
+		float4_t dd[6];
+		float4_t ax[6];
+		float4_t ay[6];
+		float4_t az[6];
+	};
+
+	inline void cullPlanes(CullPlanes& _result, const float _planes[24])
+	{
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			const float* plane = &_planes[ii*4];
+			_result.nx[ii] = float4_splat(plane[0]);
+			_result.ny[ii] = float4_splat(plane[1]);
+			_result.nz[ii] = float4_splat(plane[2]);
+			_result.dd[ii] = float4_splat(plane[3]);
+			_result.ax[ii] = float4_splat(fabsf(plane[0]) );
+			_result.ay[ii] = float4_splat(fabsf(plane[1]) );
+			_result.az[ii] = float4_splat(fabsf(plane[2]) );
+		}
+	}
+
+	/// Returns lanes of spheres outside of frustum. _in is x, y, z and
+	/// radius.
+	BX_FLOAT4_FORCE_INLINE float4_t cullSphereOutside(const CullPlanes& _planes, const float4_t* _in)
+	{
+		const float4_t zero = float4_zero();
+		float4_t outside = zero;
+
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			const float4_t tmp0 = float4_madd(_planes.nz[ii], _in[2], _planes.dd[ii]);
+			const float4_t tmp1 = float4_madd(_planes.ny[ii], _in[1], tmp0);
+			const float4_t dist = float4_madd(_planes.nx[ii], _in[0], tmp1);
+			const float4_t tmp2 = float4_add(dist, _in[3]);
+			outside = float4_or(outside, float4_cmplt(tmp2, zero) );
+		}
+
+		return outside;
+	}
+
+	/// Returns lanes of boxes outside of frustum. _in is min x, y, z and
+	/// max x, y, z.
+	BX_FLOAT4_FORCE_INLINE float4_t cullAabbOutside(const CullPlanes& _planes, const float4_t* _in)
+	{
+		const float4_t zero = float4_zero();
+		const float4_t half = float4_splat(0.5f);
+		const float4_t cx = float4_mul(float4_add(_in[0], _in[3]), half);
+		const float4_t cy = float4_mul(float4_add(_in[1], _in[4]), half);
+		const float4_t cz = float4_mul(float4_add(_in[2], _in[5]), half);
+		const float4_t ex = float4_mul(float4_sub(_in[3], _in[0]), half);
+		const float4_t ey = float4_mul(float4_sub(_in[4], _in[1]), half);
+		const float4_t ez = float4_mul(float4_sub(_in[5], _in[2]), half);
+		float4_t outside = zero;
+
+		for (uint32_t ii = 0; ii < 6; ++ii)
+		{
+			// Distance of center, plus extents projected on plane normal.
+			const float4_t tmp0 = float4_madd(_planes.nz[ii], cz, _planes.dd[ii]);
+			const float4_t tmp1 = float4_madd(_planes.ny[ii], cy, tmp0);
+			const float4_t dist = float4_madd(_planes.nx[ii], cx, tmp1);
+			const float4_t tmp2 = float4_madd(_planes.az[ii], ez, dist);
+			const float4_t tmp3 = float4_madd(_planes.ay[ii], ey, tmp2);
+			const float4_t tmp4 = float4_madd(_planes.ax[ii], ex, tmp3);
+			outside = float4_or(outside, float4_cmplt(tmp4, zero) );
+		}
+
+		return outside;
+	}
+
+	/// Runs culling kernel over SoA streams, four objects at the time, and
+	/// writes one visibility bit per object. Bits of 32 objects are
+	/// gathered in lanes and reduced once per output word.
+	template<uint32_t NumStreamsT, float4_t (*OutsideFn)(const CullPlanes&, const float4_t*)>
+	inline void cullStreams(uint32_t* _visible, const CullPlanes& _planes, const float* const* _streams, uint32_t _num)
+	{
+		const float4_t bits0 = float4_ild(1, 2, 4, 8);
+		const uint32_t numGroups = (_num+3)/4;
+		const uint32_t numFull   = _num/4;
+
+		float4_t bits = bits0;
+		float4_t acc  = float4_zero();
+		float4_t in[NumStreamsT];
+
+		for (uint32_t group = 0; group < numGroups; ++group)
+		{
+			const uint32_t index = group*4;
+
+			if (group < numFull)
+			{
+				for (uint32_t stream = 0; stream < NumStreamsT; ++stream)
+				{
+					in[stream] = float4_ldu(&_streams[stream][index]);
+				}
+			}
+			else
+			{
+				// Tail is padded with last object, its extra bits are
+				// masked below.
+				const uint32_t last = _num-1;
+				for (uint32_t stream = 0; stream < NumStreamsT; ++stream)
+				{
+					const float* src = _streams[stream];
+					in[stream] = float4_ld(src[index]
+						, src[uint32_min(index+1, last)]
+						, src[uint32_min(index+2, last)]
+						, src[uint32_min(index+3, last)]
+						);
+				}
+			}
+
+			const float4_t outside = OutsideFn(_planes, in);
+			acc  = float4_or(acc, float4_andc(bits, outside) );
+			bits = float4_sll(bits, 4);
+
+			if (7 == (group&7)
+			||  group+1 == numGroups)
+			{
+				const float4_t tmp0 = float4_or(acc, float4_swiz_zwxy(acc) );
+				const float4_t tmp1 = float4_or(tmp0, float4_swiz_yxwz(tmp0) );
+				float4_stx(&_visible[group/8], tmp1);
+
+				bits = bits0;
+				acc  = float4_zero();
+			}
+		}
+
+		const uint32_t rem = _num&31;
+		if (0 != rem)
+		{
+			_visible[_num/32] &= (UINT32_C(1)<<rem)-1;
+		}
+	}
+
+	/// Tests bounding spheres against frustum planes.
+	///
+	/// _visible receives bit per sphere, set when sphere is at least
+	/// partially inside, and it must hold (_num+31)/32 words. Streams
+	/// don't need to be aligned.
+	inline void cullSpheres(uint32_t* _visible, const float _planes[24], const float* _x, const float* _y, const float* _z, const float* _radius, uint32_t _num)
+	{
+		CullPlanes planes;
+		cullPlanes(planes, _planes);
+
+		const float* streams[4] = { _x, _y, _z, _radius };
+		cullStreams<4, cullSphereOutside>(_visible, planes, streams, _num);
+	}
+
+	/// Tests axis aligned bounding boxes against frustum planes.
+	///
+	/// _visible receives bit per box, set when box is at least partially
+	/// inside, and it must hold (_num+31)/32 words. Streams don't need to
+	/// be aligned.
+	inline void cullAabbs(uint32_t* _visible, const float _planes[24], const float* _minX, const float* _minY, const float* _minZ, const float* _maxX, const float* _maxY, const float* _maxZ, uint32_t _num)
+	{
+		CullPlanes planes;
+		cullPlanes(planes, _planes);
+
+		const float* streams[6] = { _minX, _minY, _minZ, _maxX, _maxY, _maxZ };
+		cullStreams<6, cullAabbOutside>(_visible, planes, streams, _num);
+	}
+
+} // namespace bx
+
+#endif // BX_CULL_H_HEADER_GUARD
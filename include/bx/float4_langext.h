@@ -181,6 +181,11 @@ IMPLEMENT_TEST(xyzw , 0xf);
 		return result;
 	}
 
+	BX_FLOAT4_FORCE_INLINE float4_t float4_ldu(const void* _ptr)
+	{
+		return float4_ld(_ptr);
+	}
+
 	BX_FLOAT4_FORCE_INLINE void float4_st(void* _ptr, float4_t _a)
 	{
 		uint32_t* result = reinterpret_cast<uint32_t*>(_ptr);
@@ -119,6 +119,11 @@ IMPLEMENT_TEST(xyzw , xyzw);
 		return __builtin_neon_vld1v4sf( (const __builtin_neon_sf*)_ptr);
 	}
 
+	BX_FLOAT4_FORCE_INLINE float4_t float4_ldu(const void* _ptr)
+	{
+		return float4_ld(_ptr);
+	}
+
 	BX_FLOAT4_FORCE_INLINE void float4_st(void* _ptr, float4_t _a)
 	{
 		__builtin_neon_vst1v4sf( (__builtin_neon_sf*)_ptr, _a);
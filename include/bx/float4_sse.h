@@ -137,6 +137,11 @@ IMPLEMENT_TEST(xyzw , 0xf);
 		return _mm_load_ps(reinterpret_cast<const float*>(_ptr) );
 	}
 
+	BX_FLOAT4_FORCE_INLINE float4_t float4_ldu(const void* _ptr)
+	{
+		return _mm_loadu_ps(reinterpret_cast<const float*>(_ptr) );
+	}
+
 	BX_FLOAT4_FORCE_INLINE void float4_st(void* _ptr, float4_t _a)
 	{
 		_mm_store_ps(reinterpret_cast<float*>(_ptr), _a);
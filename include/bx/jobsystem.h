@@ -0,0 +1,547 @@
+/*
+ * Copyright 2010-2013 Branimir Karadzic. All rights reserved.
+ * License: http://www.opensource.org/licenses/BSD-2-Clause
+ */
+
+#ifndef BX_JOBSYSTEM_H_HEADER_GUARD
+#define BX_JOBSYSTEM_H_HEADER_GUARD
+
+#include "bx.h"
+#include "allocator.h"
+#include "cpu.h"
+#include "mutex.h"
+#include "os.h"
+#include "sem.h"
+#include "thread.h"
+#include "uint32_t.h"
+
+#include <new> // placement new
+#include <string.h> // memset
+
+#ifndef BX_CONFIG_JOBSYSTEM_MAX_JOBS
+#	define BX_CONFIG_JOBSYSTEM_MAX_JOBS 4096 // per worker, must be power of 2.
+#endif // BX_CONFIG_JOBSYSTEM_MAX_JOBS
+
+#ifndef BX_CONFIG_JOBSYSTEM_SPIN_COUNT
+#	define BX_CONFIG_JOBSYSTEM_SPIN_COUNT 64
+#endif // BX_CONFIG_JOBSYSTEM_SPIN_COUNT
+
+namespace bx
+{
+	typedef void (*JobFn)(void* _userData);
+	typedef void (*ParallelForFn)(void* _userData, uint32_t _start, uint32_t _end);
+
+	/// Number of jobs still in flight. Every job spawned with a counter
+	/// increments it and decrements it once done, so a parent job can
+	/// wait on the counter for all of its children.
+	struct JobCounter
+	{
+		JobCounter()
+			: m_count(0)
+		{
+		}
+
+		volatile int32_t m_count;
+	};
+
+	struct JobStats
+	{
+		uint64_t numExecuted;      // jobs executed.
+		uint64_t numStolen;        // jobs taken from another worker's deque.
+		uint64_t numStealAttempts; // steal attempts, successful or not.
+		uint64_t numInlined;       // jobs executed on spawn because deque was full.
+	};
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+	struct Job
+	{
+		JobFn m_fn;
+		ParallelForFn m_forFn;
+		void* m_userData;
+		JobCounter* m_counter;
+		uint32_t m_start;
+		uint32_t m_end;
+		uint32_t m_grain;
+	};
+
+	// Chase-Lev work-stealing deque. Owner pushes and pops at the bottom,
+	// other threads steal from the top. Indices wrap around, only their
+	// difference is meaningful.
+	// http://neteril.org/~jeremie/Dynamic_Circular_Work_Queue.pdf
+	class JobDeque
+	{
+		BX_CLASS(JobDeque
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		JobDeque()
+			: m_jobs(NULL)
+			, m_mask(0)
+			, m_top(0)
+			, m_bottom(0)
+		{
+		}
+
+		void init(AllocatorI* _allocator, uint32_t _size)
+		{
+			BX_CHECK(0 == (_size & (_size-1) ), "Size must be power of 2 (size: %d).", _size);
+			m_jobs = (Job*)BX_ALLOC(_allocator, _size*sizeof(Job) );
+			m_mask = _size-1;
+			m_top = 0;
+			m_bottom = 0;
+		}
+
+		void shutdown(AllocatorI* _allocator)
+		{
+			BX_FREE(_allocator, m_jobs);
+			m_jobs = NULL;
+		}
+
+		bool push(const Job& _job) // owner only
+		{
+			const uint32_t bottom = uint32_t(m_bottom);
+			const uint32_t top    = uint32_t(m_top);
+			if (int32_t(bottom - top) >= int32_t(m_mask) )
+			{
+				return false;
+			}
+
+			m_jobs[bottom & m_mask] = _job;
+			memoryBarrier();
+			m_bottom = int32_t(bottom+1);
+			return true;
+		}
+
+		bool pop(Job& _job) // owner only
+		{
+			const uint32_t bottom = uint32_t(m_bottom)-1;
+			m_bottom = int32_t(bottom);
+			memoryBarrier();
+			const uint32_t top = uint32_t(m_top);
+
+			const int32_t size = int32_t(bottom - top);
+			if (0 > size)
+			{
+				m_bottom = int32_t(top);
+				return false;
+			}
+
+			_job = m_jobs[bottom & m_mask];
+			if (0 < size)
+			{
+				return true;
+			}
+
+			// Last job, race against thieves for it.
+			const bool result = int32_t(top) == atomicCompareAndSwap(&m_top, int32_t(top), int32_t(top+1) );
+			m_bottom = int32_t(top+1);
+			return result;
+		}
+
+		bool steal(Job& _job)
+		{
+			const uint32_t top = uint32_t(m_top);
+			memoryBarrier();
+			const uint32_t bottom = uint32_t(m_bottom);
+
+			if (0 >= int32_t(bottom - top) )
+			{
+				return false;
+			}
+
+			_job = m_jobs[top & m_mask];
+			return int32_t(top) == atomicCompareAndSwap(&m_top, int32_t(top), int32_t(top+1) );
+		}
+
+		bool empty() const
+		{
+			return 0 >= int32_t(uint32_t(m_bottom) - uint32_t(m_top) );
+		}
+
+	private:
+		Job* m_jobs;
+		uint32_t m_mask;
+		volatile int32_t m_top;
+		char m_pad[64]; // keep thieves and owner off the same cache line.
+		volatile int32_t m_bottom;
+	};
+
+	/// Work-stealing job system. The thread calling init becomes worker 0
+	/// and participates in work while waiting, the remaining workers run on
+	/// their own threads. Threads that are not workers may spawn and wait
+	/// too, their jobs go through a shared, locked deque.
+	class JobSystem
+	{
+		BX_CLASS(JobSystem
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		JobSystem()
+			: m_allocator(NULL)
+			, m_workers(NULL)
+			, m_numWorkers(0)
+			, m_numSleeping(0)
+			, m_exit(false)
+		{
+		}
+
+		~JobSystem()
+		{
+			BX_CHECK(NULL == m_workers, "Job system is not shutdown.");
+		}
+
+		void init(AllocatorI* _allocator, uint32_t _numThreads)
+		{
+			m_allocator = _allocator;
+			m_numWorkers = uint32_max(1, _numThreads);
+			m_numSleeping = 0;
+			m_exit = false;
+			m_inject.init(m_allocator, BX_CONFIG_JOBSYSTEM_MAX_JOBS);
+
+			m_workers = (Worker**)BX_ALLOC(m_allocator, m_numWorkers*sizeof(Worker*) );
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				Worker* worker = ::new(BX_ALIGNED_ALLOC(m_allocator, sizeof(Worker), 64) ) Worker;
+				worker->m_system = this;
+				worker->m_index = ii;
+				worker->m_rng = ii*0x9e3779b9 + 1;
+				memset(&worker->m_stats, 0, sizeof(JobStats) );
+				worker->m_deque.init(m_allocator, BX_CONFIG_JOBSYSTEM_MAX_JOBS);
+				m_workers[ii] = worker;
+			}
+
+			m_tls.set(m_workers[0]);
+
+			for (uint32_t ii = 1; ii < m_numWorkers; ++ii)
+			{
+				m_workers[ii]->m_thread.init(workerThread, m_workers[ii]);
+			}
+		}
+
+		void shutdown()
+		{
+			m_exit = true;
+			memoryBarrier();
+			m_sem.post(m_numWorkers);
+
+			for (uint32_t ii = 1; ii < m_numWorkers; ++ii)
+			{
+				m_workers[ii]->m_thread.shutdown();
+			}
+
+			m_tls.set(NULL);
+
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				Worker* worker = m_workers[ii];
+				worker->m_deque.shutdown(m_allocator);
+				worker->~Worker();
+				BX_ALIGNED_FREE(m_allocator, worker, 64);
+			}
+
+			BX_FREE(m_allocator, m_workers);
+			m_workers = NULL;
+			m_numWorkers = 0;
+
+			m_inject.shutdown(m_allocator);
+		}
+
+		uint32_t getNumThreads() const
+		{
+			return m_numWorkers;
+		}
+
+		/// Spawn job. When _counter is not NULL it's incremented now and
+		/// decremented after the job is executed.
+		void run(JobFn _fn, void* _userData, JobCounter* _counter = NULL)
+		{
+			Job job;
+			job.m_fn       = _fn;
+			job.m_forFn    = NULL;
+			job.m_userData = _userData;
+			job.m_counter  = _counter;
+			job.m_start    = 0;
+			job.m_end      = 0;
+			job.m_grain    = 0;
+			spawn( (Worker*)m_tls.get(), job);
+		}
+
+		/// Execute other jobs until _counter reaches zero.
+		void wait(JobCounter* _counter)
+		{
+			Worker* worker = (Worker*)m_tls.get();
+
+			while (0 != _counter->m_count)
+			{
+				Job job;
+				if (findJob(worker, job) )
+				{
+					execute(worker, job);
+				}
+				else
+				{
+					yield();
+				}
+			}
+
+			memoryBarrier();
+		}
+
+		/// Call _fn over [0, _num) split into ranges of at most _grain
+		/// items. Ranges are split in halves, idle workers steal the largest
+		/// remaining ranges first. Returns when all items are processed.
+		void parallelFor(uint32_t _num, uint32_t _grain, ParallelForFn _fn, void* _userData)
+		{
+			if (0 == _num)
+			{
+				return;
+			}
+
+			JobCounter counter;
+			counter.m_count = 1;
+
+			Job job;
+			job.m_fn       = NULL;
+			job.m_forFn    = _fn;
+			job.m_userData = _userData;
+			job.m_counter  = &counter;
+			job.m_start    = 0;
+			job.m_end      = _num;
+			job.m_grain    = uint32_max(1, _grain);
+
+			Worker* worker = (Worker*)m_tls.get();
+			execute(worker, job);
+			wait(&counter);
+		}
+
+		void getStats(JobStats& _stats) const
+		{
+			memset(&_stats, 0, sizeof(JobStats) );
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				const JobStats& stats = m_workers[ii]->m_stats;
+				_stats.numExecuted      += stats.numExecuted;
+				_stats.numStolen        += stats.numStolen;
+				_stats.numStealAttempts += stats.numStealAttempts;
+				_stats.numInlined       += stats.numInlined;
+			}
+		}
+
+		void resetStats()
+		{
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				memset(&m_workers[ii]->m_stats, 0, sizeof(JobStats) );
+			}
+		}
+
+	private:
+		struct Worker
+		{
+			JobDeque m_deque;
+			Thread m_thread;
+			JobSystem* m_system;
+			uint32_t m_index;
+			uint32_t m_rng;
+			JobStats m_stats;
+		};
+
+		static int32_t workerThread(void* _userData)
+		{
+			Worker* worker = (Worker*)_userData;
+			return worker->m_system->workerLoop(worker);
+		}
+
+		int32_t workerLoop(Worker* _worker)
+		{
+			m_tls.set(_worker);
+
+			uint32_t spin = 0;
+			while (!m_exit)
+			{
+				Job job;
+				if (findJob(_worker, job) )
+				{
+					execute(_worker, job);
+					spin = 0;
+				}
+				else if (BX_CONFIG_JOBSYSTEM_SPIN_COUNT > ++spin)
+				{
+					yield();
+				}
+				else
+				{
+					// Spawners check m_numSleeping after publishing a job,
+					// sleepers check deques after announcing themselves, so
+					// one side always sees the other.
+					atomicInc(&m_numSleeping);
+					if (!m_exit
+					&&  !hasJobs() )
+					{
+						m_sem.wait();
+					}
+					atomicDec(&m_numSleeping);
+					spin = 0;
+				}
+			}
+
+			return 0;
+		}
+
+		void spawn(Worker* _worker, const Job& _job)
+		{
+			if (NULL != _job.m_counter)
+			{
+				atomicInc(&_job.m_counter->m_count);
+			}
+
+			bool pushed;
+			if (NULL != _worker)
+			{
+				pushed = _worker->m_deque.push(_job);
+			}
+			else
+			{
+				MutexScope lock(m_injectMutex);
+				pushed = m_inject.push(_job);
+			}
+
+			if (!pushed)
+			{
+				if (NULL != _worker)
+				{
+					++_worker->m_stats.numInlined;
+				}
+
+				execute(_worker, _job);
+				return;
+			}
+
+			memoryBarrier();
+			if (0 != m_numSleeping)
+			{
+				m_sem.post();
+			}
+		}
+
+		void execute(Worker* _worker, Job _job)
+		{
+			if (NULL != _job.m_forFn)
+			{
+				while (_job.m_end - _job.m_start > _job.m_grain)
+				{
+					Job half = _job;
+					half.m_start = _job.m_start + (_job.m_end - _job.m_start)/2;
+					_job.m_end = half.m_start;
+					spawn(_worker, half);
+				}
+
+				_job.m_forFn(_job.m_userData, _job.m_start, _job.m_end);
+			}
+			else
+			{
+				_job.m_fn(_job.m_userData);
+			}
+
+			if (NULL != _worker)
+			{
+				++_worker->m_stats.numExecuted;
+			}
+
+			if (NULL != _job.m_counter)
+			{
+				atomicDec(&_job.m_counter->m_count);
+			}
+		}
+
+		bool findJob(Worker* _worker, Job& _job)
+		{
+			if (NULL != _worker
+			&&  _worker->m_deque.pop(_job) )
+			{
+				return true;
+			}
+
+			if (!m_inject.empty()
+			&&  m_inject.steal(_job) )
+			{
+				return true;
+			}
+
+			uint32_t start = 0;
+			if (NULL != _worker)
+			{
+				// xorshift32, start from random victim to spread thieves.
+				uint32_t rng = _worker->m_rng;
+				rng ^= rng<<13;
+				rng ^= rng>>17;
+				rng ^= rng<<5;
+				_worker->m_rng = rng;
+				start = rng;
+			}
+
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				Worker* victim = m_workers[(start+ii)%m_numWorkers];
+				if (victim == _worker
+				||  victim->m_deque.empty() )
+				{
+					continue;
+				}
+
+				const bool stolen = victim->m_deque.steal(_job);
+
+				if (NULL != _worker)
+				{
+					++_worker->m_stats.numStealAttempts;
+					_worker->m_stats.numStolen += stolen;
+				}
+
+				if (stolen)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool hasJobs() const
+		{
+			if (!m_inject.empty() )
+			{
+				return true;
+			}
+
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				if (!m_workers[ii]->m_deque.empty() )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		AllocatorI* m_allocator;
+		Worker** m_workers;
+		uint32_t m_numWorkers;
+		volatile int32_t m_numSleeping;
+		volatile bool m_exit;
+		JobDeque m_inject;
+		Mutex m_injectMutex;
+		Semaphore m_sem;
+		TlsData m_tls;
+	};
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+} // namespace bx
+
+#endif // BX_JOBSYSTEM_H_HEADER_GUARD
@@ -94,6 +94,20 @@ namespace bx
 #endif //
 	}
 
+	inline uint32_t getNumCpus()
+	{
+#if BX_PLATFORM_WINDOWS || BX_PLATFORM_XBOX360
+		SYSTEM_INFO info;
+		::GetSystemInfo(&info);
+		return info.dwNumberOfProcessors;
+#elif BX_PLATFORM_WINRT || BX_PLATFORM_EMSCRIPTEN
+		return 1;
+#else
+		long numCpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+		return 0 < numCpus ? uint32_t(numCpus) : 1;
+#endif // BX_PLATFORM_
+	}
+
 	inline void* dlopen(const char* _filePath)
 	{
 #if BX_PLATFORM_WINDOWS
@@ -58,14 +58,10 @@
 					? 1 : 0)
 #	endif // BGFX_CONFIG_RENDERER_OPENGLES
 
+// Null renderer is always available, headless tools and trace replay
+// select it explicitly.
 #	ifndef BGFX_CONFIG_RENDERER_NULL
-#		define BGFX_CONFIG_RENDERER_NULL (!(0 \
-					|| BGFX_CONFIG_RENDERER_DIRECT3D9 \
-					|| BGFX_CONFIG_RENDERER_DIRECT3D11 \
-					|| BGFX_CONFIG_RENDERER_DIRECT3D12 \
-					|| BGFX_CONFIG_RENDERER_OPENGL \
-					|| BGFX_CONFIG_RENDERER_OPENGLES \
-					? 1 : 0) )
+#		define BGFX_CONFIG_RENDERER_NULL 1
 #	endif // BGFX_CONFIG_RENDERER_NULL
 #else
 #	ifndef BGFX_CONFIG_RENDERER_DIRECT3D9
@@ -126,7 +122,13 @@
 #endif // BGFX_CONFIG_DEBUG_OBJECT_NAME
 
 #ifndef BGFX_CONFIG_MULTITHREADED
-#	define BGFX_CONFIG_MULTITHREADED ( (!BGFX_CONFIG_RENDERER_NULL)&&(0 \
+#	define BGFX_CONFIG_MULTITHREADED ( (0 \
+						|| BGFX_CONFIG_RENDERER_DIRECT3D9 \
+						|| BGFX_CONFIG_RENDERER_DIRECT3D11 \
+						|| BGFX_CONFIG_RENDERER_DIRECT3D12 \
+						|| BGFX_CONFIG_RENDERER_OPENGL \
+						|| BGFX_CONFIG_RENDERER_OPENGLES \
+						)&&(0 \
 						|| BX_PLATFORM_ANDROID \
 						|| BX_PLATFORM_IOS \
 						|| BX_PLATFORM_LINUX \
@@ -141,14 +143,18 @@
 #endif // BGFX_CONFIG_MULTITHREADED
 
 #ifndef BGFX_CONFIG_MAX_DRAW_CALLS
+// Default and upper limit of draw calls per frame, sort values are 16-bit.
+// See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
 #ifndef BGFX_CONFIG_MAX_MATRIX_CACHE
+// Default number of transform matrices per frame. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_MATRIX_CACHE (64<<10)
 #endif // BGFX_CONFIG_MAX_MATRIX_CACHE
 
 #ifndef BGFX_CONFIG_MAX_RECT_CACHE
+// Default number of scissor rectangles per frame. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_RECT_CACHE (4<<10)
 #endif //  BGFX_CONFIG_MAX_RECT_CACHE
 
@@ -158,22 +164,27 @@
 #endif // BGFX_CONFIG_MAX_VIEWS
 
 #ifndef BGFX_CONFIG_MAX_VERTEX_DECLS
+// Default number of vertex declaration handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_VERTEX_DECLS 64
 #endif // BGFX_CONFIG_MAX_VERTEX_DECLS
 
 #ifndef BGFX_CONFIG_MAX_INDEX_BUFFERS
+// Default number of index buffer handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_INDEX_BUFFERS (4<<10)
 #endif // BGFX_CONFIG_MAX_INDEX_BUFFERS
 
 #ifndef BGFX_CONFIG_MAX_VERTEX_BUFFERS
+// Default number of vertex buffer handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_VERTEX_BUFFERS (4<<10)
 #endif // BGFX_CONFIG_MAX_VERTEX_BUFFERS
 
 #ifndef BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS
+// Default number of dynamic index buffer handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS (4<<10)
 #endif // BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS
 
 #ifndef BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS
+// Default number of dynamic vertex buffer handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS (4<<10)
 #endif // BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS
 
@@ -185,16 +196,31 @@
 #	define BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE (3<<20)
 #endif // BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE
 
+#ifndef BGFX_CONFIG_DYNAMIC_BUFFER_TRIM_FRAMES
+// Number of frames dynamic buffer backing buffer must stay empty before
+// it's released.
+#	define BGFX_CONFIG_DYNAMIC_BUFFER_TRIM_FRAMES 16
+#endif // BGFX_CONFIG_DYNAMIC_BUFFER_TRIM_FRAMES
+
+#ifndef BGFX_CONFIG_DYNAMIC_BUFFER_MAX_RELOCATIONS
+// Maximum number of dynamic buffers moved out of sparse backing buffer
+// per frame. Set to 0 to disable compaction.
+#	define BGFX_CONFIG_DYNAMIC_BUFFER_MAX_RELOCATIONS 16
+#endif // BGFX_CONFIG_DYNAMIC_BUFFER_MAX_RELOCATIONS
+
 #ifndef BGFX_CONFIG_MAX_SHADERS
+// Default number of shader handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_SHADERS 512
 #endif // BGFX_CONFIG_MAX_FRAGMENT_SHADERS
 
 #ifndef BGFX_CONFIG_MAX_PROGRAMS
-// Must be power of 2.
+// Default and upper limit of program handles, program index is encoded
+// in sort key. Must be power of 2. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_PROGRAMS 512
 #endif // BGFX_CONFIG_MAX_PROGRAMS
 
 #ifndef BGFX_CONFIG_MAX_TEXTURES
+// Default number of texture handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_TEXTURES (4<<10)
 #endif // BGFX_CONFIG_MAX_TEXTURES
 
@@ -202,15 +228,38 @@
 #	define BGFX_CONFIG_MAX_TEXTURE_SAMPLERS 16
 #endif // BGFX_CONFIG_MAX_TEXTURE_SAMPLERS
 
+#ifndef BGFX_CONFIG_MAX_VAO_STATES
+// Must be power of 2.
+#	define BGFX_CONFIG_MAX_VAO_STATES 1024
+#endif // BGFX_CONFIG_MAX_VAO_STATES
+
+#ifndef BGFX_CONFIG_MAX_SAMPLER_STATES
+// Must be power of 2.
+#	define BGFX_CONFIG_MAX_SAMPLER_STATES 256
+#endif // BGFX_CONFIG_MAX_SAMPLER_STATES
+
 #ifndef BGFX_CONFIG_MAX_FRAME_BUFFERS
+// Default number of frame buffer handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_FRAME_BUFFERS 64
 #endif // BGFX_CONFIG_MAX_FRAME_BUFFERS
 
+#ifndef BGFX_CONFIG_MAX_TRANSIENT_FRAME_BUFFERS
+// Maximum number of frame buffers kept in transient frame buffer pool.
+#	define BGFX_CONFIG_MAX_TRANSIENT_FRAME_BUFFERS 32
+#endif // BGFX_CONFIG_MAX_TRANSIENT_FRAME_BUFFERS
+
+#ifndef BGFX_CONFIG_TRANSIENT_FRAME_BUFFER_TRIM_FRAMES
+// Number of frames pooled transient frame buffer must stay unused before
+// it's released.
+#	define BGFX_CONFIG_TRANSIENT_FRAME_BUFFER_TRIM_FRAMES 16
+#endif // BGFX_CONFIG_TRANSIENT_FRAME_BUFFER_TRIM_FRAMES
+
 #ifndef BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
 #	define BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS 8
 #endif // BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS
 
 #ifndef BGFX_CONFIG_MAX_UNIFORMS
+// Default number of uniform handles. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_UNIFORMS 512
 #endif // BGFX_CONFIG_MAX_CONSTANTS
 
@@ -219,14 +268,23 @@
 #endif // BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
 
 #ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
+// Default transient vertex buffer size. See: bgfx::Limits.
 #	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
 #endif // BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 
 #ifndef BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
+// Default transient index buffer size. See: bgfx::Limits.
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Number of debug text cells kept on GPU between frames. Larger debug
+/// text is rebuilt every frame.
+#ifndef BGFX_CONFIG_MAX_DEBUG_TEXT_CELLS
+#	define BGFX_CONFIG_MAX_DEBUG_TEXT_CELLS (16<<10)
+#endif // BGFX_CONFIG_MAX_DEBUG_TEXT_CELLS
+
 #ifndef BGFX_CONFIG_MAX_CONSTANT_BUFFER_SIZE
+// Default size of uniform data per frame. See: bgfx::Limits.
 #	define BGFX_CONFIG_MAX_CONSTANT_BUFFER_SIZE (512<<10)
 #endif // BGFX_CONFIG_MAX_CONSTANT_BUFFER_SIZE
 
@@ -242,4 +300,45 @@
 #	define BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE 16
 #endif // BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE
 
+/// Upper limit of frames in flight between API and render thread.
+#ifndef BGFX_CONFIG_MAX_FRAMES
+#	define BGFX_CONFIG_MAX_FRAMES 4
+#endif // BGFX_CONFIG_MAX_FRAMES
+
+/// Number of recent frames used to predict render and submit time for
+/// frame pacing.
+#ifndef BGFX_CONFIG_FRAME_PACING_HISTORY
+#	define BGFX_CONFIG_FRAME_PACING_HISTORY 16
+#endif // BGFX_CONFIG_FRAME_PACING_HISTORY
+
+/// Safety margin in microseconds bgfx::waitFrameStart leaves between
+/// predicted submit and moment render thread runs out of work.
+#ifndef BGFX_CONFIG_FRAME_PACING_MARGIN
+#	define BGFX_CONFIG_FRAME_PACING_MARGIN 500
+#endif // BGFX_CONFIG_FRAME_PACING_MARGIN
+
+/// Upper limit of job system threads created at init, including the
+/// thread calling init. Actual number is clamped to number of CPUs.
+#ifndef BGFX_CONFIG_MAX_WORKER_THREADS
+#	define BGFX_CONFIG_MAX_WORKER_THREADS 8
+#endif // BGFX_CONFIG_MAX_WORKER_THREADS
+
+/// Enable CPU profiler zones. When enabled, zones are captured only while
+/// BGFX_DEBUG_PROFILER debug flag is set.
+#ifndef BGFX_CONFIG_PROFILER
+#	define BGFX_CONFIG_PROFILER 1
+#endif // BGFX_CONFIG_PROFILER
+
+/// Number of most recent profiler zones kept per thread.
+#ifndef BGFX_CONFIG_PROFILER_MAX_ZONES
+#	define BGFX_CONFIG_PROFILER_MAX_ZONES (8<<10)
+#endif // BGFX_CONFIG_PROFILER_MAX_ZONES
+
+/// Minimum number of threads recording profiler zones. Rings are allocated
+/// when profiling is first enabled, and always cover job system threads and
+/// render thread.
+#ifndef BGFX_CONFIG_PROFILER_MAX_THREADS
+#	define BGFX_CONFIG_PROFILER_MAX_THREADS 4
+#endif // BGFX_CONFIG_PROFILER_MAX_THREADS
+
 #endif // BGFX_CONFIG_H_HEADER_GUARD
@@ -125,11 +125,12 @@ namespace bgfx
 	{
 		IndexBufferD3D9()
 			: m_ptr(NULL)
+			, m_flags(BGFX_BUFFER_NONE)
 			, m_dynamic(false)
 		{
 		}
 
-		void create(uint32_t _size, void* _data);
+		void create(uint32_t _size, void* _data, uint8_t _flags);
 		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
 		{
 			void* buffer;
@@ -158,6 +159,7 @@ namespace bgfx
 
 		IDirect3DIndexBuffer9* m_ptr;
 		uint32_t m_size;
+		uint8_t m_flags;
 		bool m_dynamic;
 	};
 
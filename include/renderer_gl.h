@@ -376,6 +376,18 @@ typedef uint64_t GLuint64;
 #	define GL_DEPTH_COMPONENT32F 0x8CAC
 #endif // GL_DEPTH_COMPONENT32F
 
+#ifndef GL_COLOR
+#	define GL_COLOR 0x1800
+#endif // GL_COLOR
+
+#ifndef GL_DEPTH
+#	define GL_DEPTH 0x1801
+#endif // GL_DEPTH
+
+#ifndef GL_STENCIL
+#	define GL_STENCIL 0x1802
+#endif // GL_STENCIL
+
 #ifndef GL_DEPTH_STENCIL_ATTACHMENT
 #	define GL_DEPTH_STENCIL_ATTACHMENT 0x821A
 #endif // GL_DEPTH_STENCIL_ATTACHMENT
@@ -550,27 +562,360 @@ namespace bgfx
 #define GL_IMPORT(_optional, _proto, _func, _import) extern _proto _func
 #include "glimports.h"
 
+	// Shadow of GL binding and enable state. Binds and enables matching
+	// shadow are filtered before reaching the driver. Issued and filtered
+	// calls are counted per category, counters of last frame are kept in
+	// m_last. Shadow is per GL context, it must be invalidated whenever
+	// other context is made current.
+	struct GlState
+	{
+		enum { Unknown = UINT32_MAX };
+
+		GlState()
+		{
+			invalidate();
+			memset(m_issued, 0, sizeof(m_issued) );
+			memset(m_filtered, 0, sizeof(m_filtered) );
+			memset(m_last, 0, sizeof(m_last) );
+			memset(m_lastFiltered, 0, sizeof(m_lastFiltered) );
+		}
+
+		void invalidate()
+		{
+			memset(m_buffer, 0xff, sizeof(m_buffer) );
+			memset(m_texture, 0xff, sizeof(m_texture) );
+			memset(m_sampler, 0xff, sizeof(m_sampler) );
+			m_activeTexture = Unknown;
+			m_program = Unknown;
+			m_drawFramebuffer = Unknown;
+			m_readFramebuffer = Unknown;
+			m_vertexArray = Unknown;
+			m_numCaps = 0;
+		}
+
+		void frame()
+		{
+			memcpy(m_last, m_issued, sizeof(m_issued) );
+			memcpy(m_lastFiltered, m_filtered, sizeof(m_filtered) );
+			memset(m_issued, 0, sizeof(m_issued) );
+			memset(m_filtered, 0, sizeof(m_filtered) );
+		}
+
+		void count(GlCall::Enum _call)
+		{
+			m_issued[_call]++;
+		}
+
+		bool filter(GlCall::Enum _call, uint32_t& _shadow, uint32_t _value)
+		{
+			if (_shadow == _value)
+			{
+				m_filtered[_call]++;
+				return true;
+			}
+
+			_shadow = _value;
+			m_issued[_call]++;
+			return false;
+		}
+
+		void bindBuffer(GLenum _target, GLuint _id)
+		{
+			const uint32_t idx = GL_ELEMENT_ARRAY_BUFFER == _target;
+			if (!filter(GlCall::BindBuffer, m_buffer[idx], _id) )
+			{
+				GL_CHECK(glBindBuffer(_target, _id) );
+			}
+		}
+
+		void deleteBuffers(GLsizei _num, const GLuint* _ids)
+		{
+			for (GLsizei ii = 0; ii < _num; ++ii)
+			{
+				unbind(m_buffer, BX_COUNTOF(m_buffer), _ids[ii]);
+			}
+			GL_CHECK(glDeleteBuffers(_num, _ids) );
+		}
+
+		void activeTexture(GLenum _unit)
+		{
+			if (!filter(GlCall::ActiveTexture, m_activeTexture, _unit - GL_TEXTURE0) )
+			{
+				GL_CHECK(glActiveTexture(_unit) );
+			}
+		}
+
+		void bindTexture(GLenum _target, GLuint _id)
+		{
+			const uint32_t target = getTextureTarget(_target);
+			if (m_activeTexture < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS
+			&&  target < BX_COUNTOF(m_texture[0]) )
+			{
+				if (filter(GlCall::BindTexture, m_texture[m_activeTexture][target], _id) )
+				{
+					return;
+				}
+			}
+			else
+			{
+				m_issued[GlCall::BindTexture]++;
+			}
+
+			GL_CHECK(glBindTexture(_target, _id) );
+		}
+
+		void deleteTextures(GLsizei _num, const GLuint* _ids)
+		{
+			for (GLsizei ii = 0; ii < _num; ++ii)
+			{
+				unbind(&m_texture[0][0], sizeof(m_texture)/sizeof(m_texture[0][0]), _ids[ii]);
+			}
+			GL_CHECK(glDeleteTextures(_num, _ids) );
+		}
+
+		void bindSampler(GLuint _unit, GLuint _id)
+		{
+			if (_unit >= BGFX_CONFIG_MAX_TEXTURE_SAMPLERS
+			||  !filter(GlCall::BindSampler, m_sampler[_unit], _id) )
+			{
+				GL_CHECK(glBindSampler(_unit, _id) );
+			}
+		}
+
+		void deleteSamplers(GLsizei _num, const GLuint* _ids)
+		{
+			for (GLsizei ii = 0; ii < _num; ++ii)
+			{
+				unbind(m_sampler, BX_COUNTOF(m_sampler), _ids[ii]);
+			}
+			GL_CHECK(glDeleteSamplers(_num, _ids) );
+		}
+
+		void useProgram(GLuint _id)
+		{
+			if (!filter(GlCall::UseProgram, m_program, _id) )
+			{
+				GL_CHECK(glUseProgram(_id) );
+			}
+		}
+
+		void deleteProgram(GLuint _id)
+		{
+			unbind(&m_program, 1, _id);
+			GL_CHECK(glDeleteProgram(_id) );
+		}
+
+		void bindFramebuffer(GLenum _target, GLuint _id)
+		{
+			if (GL_FRAMEBUFFER == _target)
+			{
+				if (m_drawFramebuffer == _id
+				&&  m_readFramebuffer == _id)
+				{
+					m_filtered[GlCall::BindFramebuffer]++;
+					return;
+				}
+
+				m_drawFramebuffer = _id;
+				m_readFramebuffer = _id;
+				m_issued[GlCall::BindFramebuffer]++;
+			}
+			else if (filter(GlCall::BindFramebuffer
+					, GL_READ_FRAMEBUFFER == _target ? m_readFramebuffer : m_drawFramebuffer
+					, _id
+					) )
+			{
+				return;
+			}
+
+			GL_CHECK(glBindFramebuffer(_target, _id) );
+		}
+
+		void deleteFramebuffers(GLsizei _num, const GLuint* _ids)
+		{
+			for (GLsizei ii = 0; ii < _num; ++ii)
+			{
+				unbind(&m_drawFramebuffer, 1, _ids[ii]);
+				unbind(&m_readFramebuffer, 1, _ids[ii]);
+			}
+			GL_CHECK(glDeleteFramebuffers(_num, _ids) );
+		}
+
+		void bindVertexArray(GLuint _id)
+		{
+			if (!filter(GlCall::BindVertexArray, m_vertexArray, _id) )
+			{
+				// Element array buffer binding is part of VAO state.
+				m_buffer[1] = Unknown;
+				GL_CHECK(glBindVertexArray(_id) );
+			}
+		}
+
+		void deleteVertexArrays(GLsizei _num, const GLuint* _ids)
+		{
+			for (GLsizei ii = 0; ii < _num; ++ii)
+			{
+				if (m_vertexArray == _ids[ii])
+				{
+					m_vertexArray = 0;
+					m_buffer[1] = Unknown;
+				}
+			}
+			GL_CHECK(glDeleteVertexArrays(_num, _ids) );
+		}
+
+		void enable(GLenum _cap, bool _enable)
+		{
+			uint32_t ii = 0;
+			for (; ii < m_numCaps && m_cap[ii] != _cap; ++ii)
+			{
+			}
+
+			if (ii == m_numCaps
+			&&  m_numCaps < BX_COUNTOF(m_cap) )
+			{
+				m_cap[ii] = _cap;
+				m_capState[ii] = Unknown;
+				m_numCaps++;
+			}
+
+			if (ii < m_numCaps
+			&&  filter(GlCall::Enable, m_capState[ii], _enable) )
+			{
+				return;
+			}
+
+			if (ii == m_numCaps)
+			{
+				m_issued[GlCall::Enable]++;
+			}
+
+			if (_enable)
+			{
+				GL_CHECK(glEnable(_cap) );
+			}
+			else
+			{
+				GL_CHECK(glDisable(_cap) );
+			}
+		}
+
+		void enablei(GLenum _cap, GLuint _index, bool _enable)
+		{
+			// Indexed state makes shadow of whole cap unknown.
+			for (uint32_t ii = 0; ii < m_numCaps; ++ii)
+			{
+				if (m_cap[ii] == _cap)
+				{
+					m_capState[ii] = Unknown;
+				}
+			}
+
+			m_issued[GlCall::Enable]++;
+
+			if (_enable)
+			{
+				GL_CHECK(glEnablei(_cap, _index) );
+			}
+			else
+			{
+				GL_CHECK(glDisablei(_cap, _index) );
+			}
+		}
+
+		static uint32_t getTextureTarget(GLenum _target)
+		{
+			switch (_target)
+			{
+			case GL_TEXTURE_2D:       return 0;
+			case GL_TEXTURE_CUBE_MAP: return 1;
+			case GL_TEXTURE_3D:       return 2;
+			default:                  break;
+			}
+
+			return UINT32_MAX;
+		}
+
+		static void unbind(uint32_t* _shadow, uint32_t _num, GLuint _id)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				if (_shadow[ii] == _id)
+				{
+					_shadow[ii] = 0;
+				}
+			}
+		}
+
+		uint32_t m_buffer[2];
+		uint32_t m_texture[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS][3];
+		uint32_t m_sampler[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+		uint32_t m_activeTexture;
+		uint32_t m_program;
+		uint32_t m_drawFramebuffer;
+		uint32_t m_readFramebuffer;
+		uint32_t m_vertexArray;
+
+		GLenum m_cap[16];
+		uint32_t m_capState[16];
+		uint32_t m_numCaps;
+
+		uint32_t m_issued[GlCall::Count];
+		uint32_t m_filtered[GlCall::Count];
+		uint32_t m_last[GlCall::Count];
+		uint32_t m_lastFiltered[GlCall::Count];
+	};
+
+	extern GlState g_glState;
+
+	struct VaoKey
+	{
+		bool operator==(const VaoKey& _rhs) const
+		{
+			return m_vertexBuffer       == _rhs.m_vertexBuffer
+				&& m_indexBuffer        == _rhs.m_indexBuffer
+				&& m_instanceDataBuffer == _rhs.m_instanceDataBuffer
+				&& m_instanceDataOffset == _rhs.m_instanceDataOffset
+				&& m_instanceDataStride == _rhs.m_instanceDataStride
+				&& m_vertexDecl         == _rhs.m_vertexDecl
+				&& m_program            == _rhs.m_program
+				;
+		}
+
+		uint32_t m_instanceDataOffset;
+		uint16_t m_instanceDataStride;
+		uint16_t m_vertexBuffer;
+		uint16_t m_indexBuffer;
+		uint16_t m_instanceDataBuffer;
+		uint16_t m_vertexDecl;
+		uint16_t m_program;
+	};
+
 	class VaoStateCache
 	{
 	public:
-		GLuint add(uint32_t _hash)
+		GLuint add(const VaoKey& _key, uint32_t _hash)
 		{
-			invalidate(_hash);
-
 			GLuint arrayId;
 			GL_CHECK(glGenVertexArrays(1, &arrayId) );
 
-			m_hashMap.insert(stl::make_pair(_hash, arrayId) );
+			// Only VAO bound is the most recently used one, evicted VAO is
+			// never bound.
+			GLuint evicted = 0;
+			if (m_cache.add(_key, _hash, arrayId, evicted) )
+			{
+				g_glState.deleteVertexArrays(1, &evicted);
+			}
 
 			return arrayId;
 		}
 
-		GLuint find(uint32_t _hash)
+		GLuint find(const VaoKey& _key, uint32_t _hash)
 		{
-			HashMap::iterator it = m_hashMap.find(_hash);
-			if (it != m_hashMap.end() )
+			GLuint* arrayId = m_cache.find(_key, _hash);
+			if (NULL != arrayId)
 			{
-				return it->second;
+				return *arrayId;
 			}
 
 			return UINT32_MAX;
@@ -578,35 +923,49 @@ namespace bgfx
 
 		void invalidate(uint32_t _hash)
 		{
-			GL_CHECK(glBindVertexArray(0) );
+			g_glState.bindVertexArray(0);
 
-			HashMap::iterator it = m_hashMap.find(_hash);
-			if (it != m_hashMap.end() )
+			GLuint arrayId;
+			while (m_cache.remove(_hash, arrayId) )
 			{
-				GL_CHECK(glDeleteVertexArrays(1, &it->second) );
-				m_hashMap.erase(it);
+				g_glState.deleteVertexArrays(1, &arrayId);
 			}
 		}
 
 		void invalidate()
 		{
-			GL_CHECK(glBindVertexArray(0) );
+			g_glState.bindVertexArray(0);
 
-			for (HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			GLuint arrayId;
+			while (m_cache.evict(arrayId) )
 			{
-				GL_CHECK(glDeleteVertexArrays(1, &it->second) );
+				g_glState.deleteVertexArrays(1, &arrayId);
 			}
-			m_hashMap.clear();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_cache.getCount();
+		}
+
+		uint32_t getHits() const
+		{
+			return m_cache.getHits();
+		}
+
+		uint32_t getMisses() const
+		{
+			return m_cache.getMisses();
+		}
+
+		uint32_t getEvictions() const
+		{
+			return m_cache.getEvictions();
 		}
 
 	private:
-		typedef stl::unordered_map<uint32_t, GLuint> HashMap;
-		HashMap m_hashMap;
+		BX_STATIC_ASSERT(2 <= BGFX_CONFIG_MAX_VAO_STATES);
+		LruCacheT<VaoKey, GLuint, BGFX_CONFIG_MAX_VAO_STATES> m_cache;
 	};
 
 	class VaoCacheRef
@@ -634,24 +993,47 @@ namespace bgfx
 	class SamplerStateCache
 	{
 	public:
-		GLuint add(uint32_t _hash)
+		SamplerStateCache()
+			: m_garbage(NULL)
+			, m_numGarbage(0)
+			, m_maxGarbage(0)
+		{
+		}
+
+		~SamplerStateCache()
 		{
-			invalidate(_hash);
+			BX_FREE(g_allocator, m_garbage);
+		}
 
+		GLuint add(uint32_t _hash)
+		{
 			GLuint samplerId;
 			GL_CHECK(glGenSamplers(1, &samplerId) );
 
-			m_hashMap.insert(stl::make_pair(_hash, samplerId) );
+			// Evicted sampler might still be bound to other stage until end
+			// of frame, its deletion is deferred to gc. Garbage list grows
+			// instead, when frame evicts more samplers than it holds.
+			GLuint evicted = 0;
+			if (m_cache.add(_hash, _hash, samplerId, evicted) )
+			{
+				if (m_maxGarbage == m_numGarbage)
+				{
+					m_maxGarbage = bx::uint32_max(64, m_maxGarbage*2);
+					m_garbage = (GLuint*)BX_REALLOC(g_allocator, m_garbage, m_maxGarbage*sizeof(GLuint) );
+				}
+
+				m_garbage[m_numGarbage++] = evicted;
+			}
 
 			return samplerId;
 		}
 
 		GLuint find(uint32_t _hash)
 		{
-			HashMap::iterator it = m_hashMap.find(_hash);
-			if (it != m_hashMap.end() )
+			GLuint* samplerId = m_cache.find(_hash, _hash);
+			if (NULL != samplerId)
 			{
-				return it->second;
+				return *samplerId;
 			}
 
 			return UINT32_MAX;
@@ -659,31 +1041,59 @@ namespace bgfx
 
 		void invalidate(uint32_t _hash)
 		{
-			HashMap::iterator it = m_hashMap.find(_hash);
-			if (it != m_hashMap.end() )
+			GLuint samplerId;
+			if (m_cache.remove(_hash, samplerId) )
 			{
-				GL_CHECK(glDeleteSamplers(1, &it->second) );
-				m_hashMap.erase(it);
+				g_glState.deleteSamplers(1, &samplerId);
 			}
 		}
 
 		void invalidate()
 		{
-			for (HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			GLuint samplerId;
+			while (m_cache.evict(samplerId) )
 			{
-				GL_CHECK(glDeleteSamplers(1, &it->second) );
+				g_glState.deleteSamplers(1, &samplerId);
+			}
+
+			gc();
+		}
+
+		void gc()
+		{
+			if (0 != m_numGarbage)
+			{
+				g_glState.deleteSamplers(m_numGarbage, m_garbage);
+				m_numGarbage = 0;
 			}
-			m_hashMap.clear();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_cache.getCount();
+		}
+
+		uint32_t getHits() const
+		{
+			return m_cache.getHits();
+		}
+
+		uint32_t getMisses() const
+		{
+			return m_cache.getMisses();
+		}
+
+		uint32_t getEvictions() const
+		{
+			return m_cache.getEvictions();
 		}
 
 	private:
-		typedef stl::unordered_map<uint32_t, GLuint> HashMap;
-		HashMap m_hashMap;
+		BX_STATIC_ASSERT(BGFX_CONFIG_MAX_TEXTURE_SAMPLERS <= BGFX_CONFIG_MAX_SAMPLER_STATES);
+		LruCacheT<uint32_t, GLuint, BGFX_CONFIG_MAX_SAMPLER_STATES> m_cache;
+		GLuint* m_garbage;
+		uint32_t m_numGarbage;
+		uint32_t m_maxGarbage;
 	};
 
 	struct IndexBufferGL
@@ -694,25 +1104,25 @@ namespace bgfx
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BX_CHECK(0 != m_id, "Failed to generate buffer id.");
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+			g_glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
 			GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER
 				, _size
 				, _data
 				, (NULL==_data)?GL_DYNAMIC_DRAW:GL_STATIC_DRAW
 				) );
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+			g_glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 		}
 
 		void update(uint32_t _offset, uint32_t _size, void* _data)
 		{
 			BX_CHECK(0 != m_id, "Updating invalid index buffer.");
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+			g_glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
 			GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
 				, _offset
 				, _size
 				, _data
 				) );
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+			g_glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 		}
 
 		void destroy();
@@ -736,25 +1146,25 @@ namespace bgfx
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BX_CHECK(0 != m_id, "Failed to generate buffer id.");
-			GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_id) );
+			g_glState.bindBuffer(GL_ARRAY_BUFFER, m_id);
 			GL_CHECK(glBufferData(GL_ARRAY_BUFFER
 				, _size
 				, _data
 				, (NULL==_data)?GL_DYNAMIC_DRAW:GL_STATIC_DRAW
 				) );
-			GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0) );
+			g_glState.bindBuffer(GL_ARRAY_BUFFER, 0);
 		}
 
 		void update(uint32_t _offset, uint32_t _size, void* _data)
 		{
 			BX_CHECK(0 != m_id, "Updating invalid vertex buffer.");
-			GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_id) );
+			g_glState.bindBuffer(GL_ARRAY_BUFFER, m_id);
 			GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER
 				, _offset
 				, _size
 				, _data
 				) );
-			GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0) );
+			g_glState.bindBuffer(GL_ARRAY_BUFFER, 0);
 		}
 
 		void destroy();
@@ -0,0 +1,102 @@
+//go:build bgfx_test
+// +build bgfx_test
+
+package bgfx
+
+import (
+	"fmt"
+	"testing"
+)
+
+func TestJobSystemParallelFor(t *testing.T) {
+	const num, work = 100000, 16
+
+	serial := newJobSystem(1)
+	want := serial.parallelFor(num, num, work)
+	serial.destroy()
+
+	for _, threads := range []int{2, 4, 8} {
+		js := newJobSystem(threads)
+		for _, grain := range []int{1, 7, 1000} {
+			if got := js.parallelFor(num, grain, work); got != want {
+				t.Errorf("threads %d grain %d: checksum %#x, want %#x", threads, grain, got, want)
+			}
+		}
+		js.destroy()
+	}
+}
+
+func TestJobSystemSpawn(t *testing.T) {
+	js := newJobSystem(4)
+	defer js.destroy()
+
+	js.stats(true)
+	js.spawn(10000)
+	if stats := js.stats(true); stats.Executed != 10000 {
+		t.Errorf("spawn: executed %d jobs, want 10000", stats.Executed)
+	}
+
+	js.spawnNested(64 * 100)
+	if stats := js.stats(true); stats.Executed != 64*100+100 {
+		t.Errorf("nested spawn: executed %d jobs, want %d", stats.Executed, 64*100+100)
+	}
+}
+
+// BenchmarkJobSpawn measures cost of spawning and waiting on an empty job.
+func BenchmarkJobSpawn(b *testing.B) {
+	for _, threads := range []int{1, 4} {
+		b.Run(fmt.Sprintf("threads=%d", threads), func(b *testing.B) {
+			js := newJobSystem(threads)
+			defer js.destroy()
+			b.ResetTimer()
+			for n := b.N; n > 0; n -= 1024 {
+				if n < 1024 {
+					js.spawn(n)
+				} else {
+					js.spawn(1024)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkJobSteal spawns children from other jobs, so most of the work
+// has to be stolen from the worker that spawned it.
+func BenchmarkJobSteal(b *testing.B) {
+	for _, threads := range []int{2, 4, 8} {
+		b.Run(fmt.Sprintf("threads=%d", threads), func(b *testing.B) {
+			js := newJobSystem(threads)
+			defer js.destroy()
+			js.stats(true)
+			b.ResetTimer()
+			for n := b.N; n > 0; n -= 4096 {
+				js.spawnNested(4096)
+			}
+			b.StopTimer()
+			stats := js.stats(true)
+			if stats.Executed > 0 {
+				b.ReportMetric(float64(stats.Stolen)/float64(stats.Executed), "steals/job")
+			}
+			if stats.StealAttempts > 0 {
+				b.ReportMetric(float64(stats.Stolen)/float64(stats.StealAttempts), "hits/attempt")
+			}
+		})
+	}
+}
+
+// BenchmarkJobScaling runs fixed amount of work over parallel for with
+// increasing number of threads.
+func BenchmarkJobScaling(b *testing.B) {
+	const num, grain, work = 1 << 16, 256, 256
+	for _, threads := range []int{1, 2, 4, 8, 16, 32} {
+		b.Run(fmt.Sprintf("threads=%d", threads), func(b *testing.B) {
+			js := newJobSystem(threads)
+			defer js.destroy()
+			b.SetBytes(num * 4)
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				js.parallelFor(num, grain, work)
+			}
+		})
+	}
+}
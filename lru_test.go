@@ -0,0 +1,139 @@
+//go:build bgfx_test
+// +build bgfx_test
+
+package bgfx
+
+import (
+	"math/rand"
+	"testing"
+)
+
+// lruModel is reference LRU cache, entries[0] is most recently used.
+type lruModel struct {
+	entries []lruEntry
+}
+
+type lruEntry struct {
+	key, hash, value uint32
+}
+
+func (m *lruModel) index(key, hash uint32) int {
+	for i, e := range m.entries {
+		if e.key == key && e.hash == hash {
+			return i
+		}
+	}
+	return -1
+}
+
+func (m *lruModel) take(i int) lruEntry {
+	e := m.entries[i]
+	m.entries = append(m.entries[:i], m.entries[i+1:]...)
+	return e
+}
+
+func (m *lruModel) push(e lruEntry) {
+	m.entries = append([]lruEntry{e}, m.entries...)
+}
+
+// lruHash maps keys into few hashes, and hashes into two home slots, so
+// probe sequences are long and entries with different hashes interleave.
+func lruHash(key uint32) uint32 {
+	return (key % 7) * 0x10
+}
+
+func TestLruCache(t *testing.T) {
+	cache := newLruCache()
+	defer cache.destroy()
+
+	var model lruModel
+	var want lruCacheStats
+	rnd := rand.New(rand.NewSource(1))
+	for op := 0; op < 100000; op++ {
+		key := uint32(rnd.Intn(64))
+		hash := lruHash(key)
+		switch rnd.Intn(8) {
+		case 0, 1, 2:
+			if model.index(key, hash) >= 0 {
+				continue
+			}
+			value := uint32(op)
+			evicted, full := cache.add(key, hash, value)
+			if full != (len(model.entries) == lruCacheTestKeys) {
+				t.Fatalf("op %d: add reported full %v with %d entries", op, full, len(model.entries))
+			}
+			if full {
+				want.Evictions++
+				if lru := model.take(len(model.entries) - 1); evicted != lru.value {
+					t.Fatalf("op %d: evicted %d, want least recently used %d", op, evicted, lru.value)
+				}
+			}
+			model.push(lruEntry{key, hash, value})
+		case 3, 4, 5:
+			value, ok := cache.find(key, hash)
+			i := model.index(key, hash)
+			if ok != (i >= 0) {
+				t.Fatalf("op %d: find key %d returned %v, want %v", op, key, ok, i >= 0)
+			}
+			if ok {
+				want.Hits++
+				e := model.take(i)
+				if value != e.value {
+					t.Fatalf("op %d: find key %d returned %d, want %d", op, key, value, e.value)
+				}
+				model.push(e)
+			} else {
+				want.Misses++
+			}
+		case 6:
+			// Removes any one entry with matching hash.
+			value, ok := cache.remove(hash)
+			i := -1
+			for j, e := range model.entries {
+				if e.hash == hash && (!ok || e.value == value) {
+					i = j
+				}
+			}
+			if ok != (i >= 0) {
+				t.Fatalf("op %d: remove hash %#x returned %v, %d", op, hash, ok, value)
+			}
+			if ok {
+				model.take(i)
+			}
+		case 7:
+			value, ok := cache.evict()
+			if ok != (len(model.entries) > 0) {
+				t.Fatalf("op %d: evict returned %v with %d entries", op, ok, len(model.entries))
+			}
+			if ok {
+				if lru := model.take(len(model.entries) - 1); value != lru.value {
+					t.Fatalf("op %d: evicted %d, want %d", op, value, lru.value)
+				}
+			}
+		}
+
+		want.Count = len(model.entries)
+		if got := cache.stats(); got != want {
+			t.Fatalf("op %d: stats %+v, want %+v", op, got, want)
+		}
+	}
+
+	// Every entry is still found after removals shifted probe sequences.
+	// Finding from least recently used keeps the order, drain must follow
+	// it.
+	for i := len(model.entries) - 1; i >= 0; i-- {
+		e := model.entries[i]
+		if _, ok := cache.find(e.key, e.hash); !ok {
+			t.Fatalf("key %d is lost", e.key)
+		}
+	}
+	for i := len(model.entries) - 1; i >= 0; i-- {
+		value, ok := cache.evict()
+		if !ok || value != model.entries[i].value {
+			t.Fatalf("drain evicted %d, %v, want %d", value, ok, model.entries[i].value)
+		}
+	}
+	if _, ok := cache.evict(); ok {
+		t.Fatal("evict from empty cache succeeded")
+	}
+}
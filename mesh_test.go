@@ -0,0 +1,237 @@
+package bgfx
+
+import (
+	"bytes"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"reflect"
+	"runtime"
+	"testing"
+)
+
+// testMesh welds vertices of size*size quad heightfield, and splits
+// triangles into two groups.
+func testMesh(size int) ([]posNormalVertex, []uint32, []MeshGroup) {
+	decl := posNormalDecl()
+	soup := triangleSoup(size, 0)
+	remap := make([]uint32, len(soup))
+	WeldVertices(remap, decl, soup, 0.001)
+	verts := make([]posNormalVertex, len(soup))
+	indices := append([]uint32(nil), remap...)
+	num := OptimizeVertexFetch(verts, remap, decl, soup, indices)
+	half := len(indices) / 6 * 3
+	groups := []MeshGroup{
+		{StartIndex: 0, NumIndices: half, StartVertex: 0, NumVertices: num},
+		{StartIndex: half, NumIndices: len(indices) - half, StartVertex: 0, NumVertices: num},
+	}
+	return verts[:num], indices, groups
+}
+
+func writeTestMesh(t testing.TB, size int) (string, []posNormalVertex, []uint32) {
+	verts, indices, groups := testMesh(size)
+	var buf bytes.Buffer
+	if err := WriteMesh(&buf, posNormalDecl(), verts, indices, groups); err != nil {
+		t.Fatal(err)
+	}
+	dir, err := ioutil.TempDir("", "bgfx")
+	if err != nil {
+		t.Fatal(err)
+	}
+	path := filepath.Join(dir, "mesh.bin")
+	if err := ioutil.WriteFile(path, buf.Bytes(), 0644); err != nil {
+		t.Fatal(err)
+	}
+	return path, verts, indices
+}
+
+func TestMesh(t *testing.T) {
+	const size = 8
+	path, verts, indices := writeTestMesh(t, size)
+	defer os.RemoveAll(filepath.Dir(path))
+
+	m, err := OpenMesh(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer m.Close()
+
+	if m.Decl != posNormalDecl() || m.NumVertices != len(verts) || !m.Index32 {
+		t.Fatalf("mesh decl %v, %d vertices, index32 %v", m.Decl, m.NumVertices, m.Index32)
+	}
+	if !bytes.Equal(m.Vertices, sliceBytes(verts)) || !reflect.DeepEqual(m.Indices32(), indices) {
+		t.Fatalf("mesh vertices or indices differ")
+	}
+	want := MeshBounds{Min: [3]float32{0, 0, 0}, Max: [3]float32{0.8, 0.08, 0.8}}
+	b := m.Bounds
+	for i := 0; i < 3; i++ {
+		if abs32(b.Min[i]-want.Min[i]) > 1e-5 || abs32(b.Max[i]-want.Max[i]) > 1e-5 ||
+			abs32(b.Sphere[i]-(want.Min[i]+want.Max[i])*0.5) > 1e-5 {
+			t.Fatalf("mesh bounds %v", b)
+		}
+	}
+	if len(m.Groups) != 2 || m.Groups[0].NumIndices+m.Groups[1].NumIndices != len(indices) {
+		t.Fatalf("mesh groups %v", m.Groups)
+	}
+	for _, g := range m.Groups {
+		for i := g.StartIndex; i < g.StartIndex+g.NumIndices; i++ {
+			p := verts[indices[i]].Pos
+			var d float32
+			for j := 0; j < 3; j++ {
+				if p[j] < g.Bounds.Min[j] || p[j] > g.Bounds.Max[j] {
+					t.Fatalf("vertex %v outside of group box %v", p, g.Bounds)
+				}
+				d += (p[j] - g.Bounds.Sphere[j]) * (p[j] - g.Bounds.Sphere[j])
+			}
+			if d > g.Bounds.Sphere[3]*g.Bounds.Sphere[3]*1.0001 {
+				t.Fatalf("vertex %v outside of group sphere %v", p, g.Bounds.Sphere)
+			}
+		}
+	}
+
+	small := []uint16{0, 1, 2}
+	var buf bytes.Buffer
+	WriteMesh(&buf, posNormalDecl(), verts[:3], small, nil)
+	data := buf.Bytes()
+	m16, err := ParseMesh(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if m16.Index32 || !reflect.DeepEqual(m16.Indices16(), small) || len(m16.Groups) != 1 {
+		t.Fatalf("16-bit mesh indices %v, groups %v", m16.Indices16(), m16.Groups)
+	}
+
+	corrupt := func(i int, v byte) []byte {
+		c := append([]byte(nil), data...)
+		c[i] = v
+		return c
+	}
+	for _, c := range [][]byte{
+		data[:len(data)-16],
+		data[:32],
+		corrupt(0, 'X'),   // magic
+		corrupt(29, 0xff), // groups offset
+		corrupt(80, 0xff), // number of attributes
+	} {
+		if _, err := ParseMesh(c); err == nil {
+			t.Errorf("corrupted mesh parsed")
+		}
+	}
+}
+
+func abs32(v float32) float32 {
+	if v < 0 {
+		return -v
+	}
+	return v
+}
+
+func TestMeshCreateBuffers(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	path, _, _ := writeTestMesh(t, 8)
+	defer os.RemoveAll(filepath.Dir(path))
+	m, err := OpenMesh(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	vb, ib := m.CreateBuffers()
+	SetVertexBuffer(vb)
+	SetIndexBuffer(ib)
+	Submit(0)
+	Frame()
+	Frame()
+	DestroyIndexBuffer(ib)
+	DestroyVertexBuffer(vb)
+	m.Close()
+
+	// Non-indexed mesh gets invalid index buffer, and draws without it.
+	verts, _, _ := testMesh(2)
+	var buf bytes.Buffer
+	WriteMesh(&buf, posNormalDecl(), verts, []uint16(nil), nil)
+	empty, err := ParseMesh(buf.Bytes())
+	if err != nil {
+		t.Fatal(err)
+	}
+	vb, ib = empty.CreateBuffers()
+	if ib.h.idx != invalidHandle || vb.h.idx == invalidHandle {
+		t.Fatalf("mesh without indices created index buffer %d", ib.h.idx)
+	}
+	SetVertexBuffer(vb)
+	SetIndexBuffer(ib)
+	Submit(0)
+	Frame()
+	DestroyIndexBuffer(ib)
+	DestroyVertexBuffer(vb)
+	Frame()
+}
+
+var meshSink byte
+
+// meshChecksum reads every byte of mesh, like upload to GPU would.
+func meshChecksum(m *Mesh) (sum byte) {
+	for _, b := range m.Vertices {
+		sum += b
+	}
+	for _, b := range m.Indices {
+		sum += b
+	}
+	return
+}
+
+// BenchmarkMeshLoad compares memory mapping mesh container against
+// reading file into memory. Both create buffers, mapped mesh references
+// file while the other is copied by bgfx, and both read every byte.
+func BenchmarkMeshLoad(b *testing.B) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	path, verts, indices := writeTestMesh(b, 256)
+	defer os.RemoveAll(filepath.Dir(path))
+	size := int64(len(verts)*24 + len(indices)*4)
+
+	load := func(b *testing.B, open func() (*Mesh, error)) {
+		b.SetBytes(size)
+		var sum byte
+		for i := 0; i < b.N; i++ {
+			m, err := open()
+			if err != nil {
+				b.Fatal(err)
+			}
+			sum += meshChecksum(m)
+			vb, ib := m.CreateBuffers()
+			Frame()
+			Frame()
+			DestroyIndexBuffer(ib)
+			DestroyVertexBuffer(vb)
+			m.Close()
+		}
+		Frame()
+		meshSink = sum
+	}
+
+	b.Run("Mapped", func(b *testing.B) {
+		load(b, func() (*Mesh, error) {
+			return OpenMesh(path)
+		})
+	})
+
+	b.Run("Copy", func(b *testing.B) {
+		load(b, func() (*Mesh, error) {
+			data, err := ioutil.ReadFile(path)
+			if err != nil {
+				return nil, err
+			}
+			return ParseMesh(data)
+		})
+	})
+}
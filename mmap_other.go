@@ -0,0 +1,27 @@
+//go:build !windows && !darwin && !freebsd && !linux
+// +build !windows,!darwin,!freebsd,!linux
+
+package bgfx
+
+import (
+	"errors"
+	"io/ioutil"
+)
+
+// Platforms without mmap read whole file into memory.
+const mmapSupported = false
+
+func mmapFile(path string) ([]byte, error) {
+	data, err := ioutil.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	if len(data) == 0 {
+		return nil, errors.New("bgfx: can't map " + path)
+	}
+	return data, nil
+}
+
+func munmapFile(data []byte) error {
+	return nil
+}
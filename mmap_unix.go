@@ -0,0 +1,33 @@
+//go:build darwin || freebsd || linux
+// +build darwin freebsd linux
+
+package bgfx
+
+import (
+	"errors"
+	"os"
+	"syscall"
+)
+
+const mmapSupported = true
+
+func mmapFile(path string) ([]byte, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	fi, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	size := fi.Size()
+	if size <= 0 || int64(int(size)) != size {
+		return nil, errors.New("bgfx: can't map " + path)
+	}
+	return syscall.Mmap(int(f.Fd()), 0, int(size), syscall.PROT_READ, syscall.MAP_SHARED)
+}
+
+func munmapFile(data []byte) error {
+	return syscall.Munmap(data)
+}
@@ -0,0 +1,47 @@
+package bgfx
+
+import (
+	"errors"
+	"os"
+	"reflect"
+	"syscall"
+	"unsafe"
+)
+
+const mmapSupported = true
+
+func mmapFile(path string) ([]byte, error) {
+	f, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+	fi, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	size := fi.Size()
+	if size <= 0 || int64(int(size)) != size {
+		return nil, errors.New("bgfx: can't map " + path)
+	}
+	h, err := syscall.CreateFileMapping(syscall.Handle(f.Fd()), nil, syscall.PAGE_READONLY, uint32(size>>32), uint32(size), nil)
+	if err != nil {
+		return nil, err
+	}
+	// view keeps file mapping alive
+	addr, err := syscall.MapViewOfFile(h, syscall.FILE_MAP_READ, 0, 0, uintptr(size))
+	syscall.CloseHandle(h)
+	if err != nil {
+		return nil, err
+	}
+	var data []byte
+	slice := (*reflect.SliceHeader)(unsafe.Pointer(&data))
+	slice.Data = addr
+	slice.Len = int(size)
+	slice.Cap = int(size)
+	return data, nil
+}
+
+func munmapFile(data []byte) error {
+	return syscall.UnmapViewOfFile(uintptr(unsafe.Pointer(&data[0])))
+}
@@ -0,0 +1,291 @@
+package bgfx
+
+import (
+	"math/rand"
+	"testing"
+	"time"
+)
+
+type occluderVertex struct {
+	X, Y, Z float32
+	U, V    float32
+}
+
+// testQuad is unit quad at z=0 facing -z.
+var testQuad = []occluderVertex{
+	{X: -1, Y: -1}, {X: 1, Y: -1}, {X: 1, Y: 1}, {X: -1, Y: 1},
+}
+
+var testQuadIndices = []uint32{0, 1, 2, 0, 2, 3}
+
+var testIdentity = [16]float32{0: 1, 5: 1, 10: 1, 15: 1}
+
+func testProj(near, far float32, oglNdc bool) [16]float32 {
+	if !oglNdc {
+		return testViewProj(near, far)
+	}
+	return [16]float32{
+		0:  1,
+		5:  1,
+		10: (far + near) / (far - near),
+		11: 1,
+		14: -2 * far * near / (far - near),
+	}
+}
+
+func TestOcclusionDepth(t *testing.T) {
+	const size = 64
+	ob := NewOcclusionBuffer(size, size)
+	defer ob.Destroy()
+
+	// Quad spans [-5, 5] at z=10, which is half of screen.
+	mtx := [16]float32{0: 5, 5: 5, 10: 1, 14: 10, 15: 1}
+	ob.Begin(testIdentity, testProj(1, 100, false), false)
+	ob.AddOccluder(mtx, testQuad, testQuadIndices)
+	ob.Rasterize()
+
+	depth := make([]float32, size*size)
+	ob.ReadDepth(depth)
+	want := float32(100.0/99.0) * (1 - 1.0/10.0)
+	covered := 0
+	for y := 0; y < size; y++ {
+		for x := 0; x < size; x++ {
+			d := depth[y*size+x]
+			inside := x >= 16 && x < 48 && y >= 16 && y < 48
+			switch {
+			case inside && abs32(d-want) > 1e-4:
+				t.Fatalf("pixel %d,%d: depth %f, want %f", x, y, d, want)
+			case !inside && d != 1:
+				t.Fatalf("pixel %d,%d: depth %f outside of occluder", x, y, d)
+			}
+			if d != 1 {
+				covered++
+			}
+		}
+	}
+	if covered != 32*32 {
+		t.Errorf("covered %d pixels, want %d", covered, 32*32)
+	}
+	if stats := ob.Stats(); stats.Occluders != 1 || stats.Triangles != 2 {
+		t.Errorf("stats %+v, want 1 occluder and 2 triangles", stats)
+	}
+}
+
+func TestOcclusionIndexRange(t *testing.T) {
+	ob := NewOcclusionBuffer(64, 64)
+	defer ob.Destroy()
+
+	ob.Begin(testIdentity, testProj(1, 100, false), false)
+	for _, indices := range [][]uint32{{0, 1, 4}, {0, 1, 2, 0, 2, 0xffffffff}} {
+		func() {
+			defer func() {
+				if recover() != errIndexRange {
+					t.Errorf("indices %v: didn't panic with errIndexRange", indices)
+				}
+			}()
+			ob.AddOccluder(testIdentity, testQuad, indices)
+		}()
+	}
+	func() {
+		defer func() {
+			if recover() != errIndexRange {
+				t.Error("indices without vertices didn't panic with errIndexRange")
+			}
+		}()
+		ob.AddOccluder(testIdentity, []occluderVertex{}, testQuadIndices)
+	}()
+	if stats := ob.Stats(); stats.Occluders != 0 {
+		t.Errorf("rejected occluders were added, stats %+v", stats)
+	}
+}
+
+func TestOcclusionBufferSize(t *testing.T) {
+	// Padded size of 0xfff9 and above doesn't fit 16 bits.
+	for _, size := range [][2]int{{0, 8}, {8, 0}, {0xfff9, 8}, {8, 0xffff}} {
+		func() {
+			defer func() {
+				if recover() == nil {
+					t.Errorf("size %dx%d didn't panic", size[0], size[1])
+				}
+			}()
+			NewOcclusionBuffer(size[0], size[1]).Destroy()
+		}()
+	}
+	ob := NewOcclusionBuffer(13, 8)
+	defer ob.Destroy()
+	if w, h := ob.Size(); w != 16 || h != 8 {
+		t.Errorf("size %dx%d, want 16x8", w, h)
+	}
+}
+
+// TestOcclusionAccuracy tests random boxes around quad occluder, and
+// checks results that are not within two pixels of occluder edges.
+func TestOcclusionAccuracy(t *testing.T) {
+	const (
+		size   = 128
+		quadZ  = 10
+		margin = 2 * 2.0 / size
+		n      = 4000
+	)
+	for _, oglNdc := range []bool{false, true} {
+		ob := NewOcclusionBuffer(size, size)
+		mtx := [16]float32{0: 5, 5: 5, 10: 1, 14: quadZ, 15: 1}
+		ob.Begin(testIdentity, testProj(1, 100, oglNdc), oglNdc)
+		ob.AddOccluder(mtx, testQuad, testQuadIndices)
+		ob.Rasterize()
+
+		rng := rand.New(rand.NewSource(3))
+		var min, max [3][]float32
+		for k := range min {
+			min[k] = make([]float32, n)
+			max[k] = make([]float32, n)
+		}
+		for i := 0; i < n; i++ {
+			z := 2 + rng.Float32()*58
+			ext := [3]float32{rng.Float32() * 3, rng.Float32() * 3, rng.Float32() * 3}
+			c := [3]float32{(rng.Float32()*1.6 - 0.8) * z, (rng.Float32()*1.6 - 0.8) * z, z}
+			for k := range c {
+				min[k][i] = c[k] - ext[k]
+				max[k][i] = c[k] + ext[k]
+			}
+		}
+		visible := make([]uint32, (n+31)/32)
+		ob.TestAABBs(visible, min[0], min[1], min[2], max[0], max[1], max[2])
+
+		numOccluded, numVisible := 0, 0
+		for i := 0; i < n; i++ {
+			if min[2][i] < 1 {
+				continue
+			}
+			// Projected bounds, x/z and y/z are extreme at corners.
+			var lo, hi [2]float32
+			for k := 0; k < 2; k++ {
+				lo[k], hi[k] = 1e9, -1e9
+				for _, v := range []float32{min[k][i], max[k][i]} {
+					for _, z := range []float32{min[2][i], max[2][i]} {
+						p := v / z
+						if p < lo[k] {
+							lo[k] = p
+						}
+						if p > hi[k] {
+							hi[k] = p
+						}
+					}
+				}
+			}
+			got := visible[i/32]&(1<<uint(i%32)) != 0
+			inside := lo[0] > -0.5+margin && hi[0] < 0.5-margin &&
+				lo[1] > -0.5+margin && hi[1] < 0.5-margin
+			outside := lo[0] < -0.5-margin || hi[0] > 0.5+margin ||
+				lo[1] < -0.5-margin || hi[1] > 0.5+margin
+			onScreen := hi[0] > -1+margin && lo[0] < 1-margin &&
+				hi[1] > -1+margin && lo[1] < 1-margin
+			switch {
+			case inside && min[2][i] > quadZ+0.01:
+				numOccluded++
+				if got {
+					t.Errorf("oglNdc=%v: box %d behind occluder is visible", oglNdc, i)
+				}
+			case onScreen && (outside || max[2][i] < quadZ-0.01):
+				numVisible++
+				if !got {
+					t.Errorf("oglNdc=%v: box %d is occluded", oglNdc, i)
+				}
+			}
+		}
+		if numOccluded < 100 || numVisible < 100 {
+			t.Errorf("oglNdc=%v: %d occluded and %d visible boxes checked", oglNdc, numOccluded, numVisible)
+		}
+		if stats := ob.Stats(); stats.Tested != n {
+			t.Errorf("oglNdc=%v: tested %d boxes, want %d", oglNdc, stats.Tested, n)
+		}
+		ob.Destroy()
+	}
+}
+
+// TestOcclusionNearClip tests ground plane crossing near plane, which
+// hides boxes under it.
+func TestOcclusionNearClip(t *testing.T) {
+	ob := NewOcclusionBuffer(256, 128)
+	defer ob.Destroy()
+
+	// Unit quad rotated to y=-2 plane, spanning z from -100 to 100.
+	mtx := [16]float32{0: 100, 6: 100, 9: 1, 13: -2, 15: 1}
+	ob.Begin(testIdentity, testProj(1, 100, false), false)
+	ob.AddOccluder(mtx, testQuad, testQuadIndices)
+	ob.Rasterize()
+
+	var visible [1]uint32
+	ob.TestAABBs(visible[:],
+		[]float32{-1, -1, -1}, []float32{-11, -1, -11}, []float32{29, 29, -1},
+		[]float32{1, 1, 1}, []float32{-9, 1, -9}, []float32{31, 31, 1})
+	if visible[0] != 6 {
+		t.Errorf("visible %03b, want 110", visible[0])
+	}
+}
+
+// testOccluders returns grid of boxes used as occluders, and boxes
+// tested against them.
+func testOccluders(numOccluders, numBoxes int) ([]occluderVertex, []uint32, [3][]float32, [3][]float32) {
+	rng := rand.New(rand.NewSource(4))
+	var verts []occluderVertex
+	var indices []uint32
+	for i := 0; i < numOccluders; i++ {
+		x := rng.Float32()*160 - 80
+		z := 10 + rng.Float32()*80
+		w := 2 + rng.Float32()*6
+		base := uint32(len(verts))
+		for _, c := range [][3]float32{
+			{x - w, -10, z - w}, {x + w, -10, z - w}, {x + w, 10, z - w}, {x - w, 10, z - w},
+			{x - w, -10, z + w}, {x + w, -10, z + w}, {x + w, 10, z + w}, {x - w, 10, z + w},
+		} {
+			verts = append(verts, occluderVertex{X: c[0], Y: c[1], Z: c[2]})
+		}
+		for _, idx := range []uint32{
+			0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6,
+			0, 4, 5, 0, 5, 1, 3, 2, 6, 3, 6, 7,
+			0, 3, 7, 0, 7, 4, 1, 5, 6, 1, 6, 2,
+		} {
+			indices = append(indices, base+idx)
+		}
+	}
+	var min, max [3][]float32
+	for k := range min {
+		min[k] = make([]float32, numBoxes)
+		max[k] = make([]float32, numBoxes)
+	}
+	for i := 0; i < numBoxes; i++ {
+		c := [3]float32{rng.Float32()*200 - 100, rng.Float32()*20 - 10, 5 + rng.Float32()*95}
+		for k := range c {
+			min[k][i] = c[k] - 1
+			max[k][i] = c[k] + 1
+		}
+	}
+	return verts, indices, min, max
+}
+
+func BenchmarkOcclusion(b *testing.B) {
+	const numBoxes = 1 << 14
+	verts, indices, min, max := testOccluders(64, numBoxes)
+	ob := NewOcclusionBuffer(320, 192)
+	defer ob.Destroy()
+	visible := make([]uint32, numBoxes/32)
+	proj := testProj(1, 100, false)
+
+	var raster, test time.Duration
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		start := time.Now()
+		ob.Begin(testIdentity, proj, false)
+		ob.AddOccluder(testIdentity, verts, indices)
+		ob.Rasterize()
+		mid := time.Now()
+		ob.TestAABBs(visible, min[0], min[1], min[2], max[0], max[1], max[2])
+		test += time.Since(mid)
+		raster += mid.Sub(start)
+	}
+	stats := ob.Stats()
+	b.ReportMetric(float64(raster.Nanoseconds())/float64(b.N*stats.Triangles), "ns/triangle")
+	b.ReportMetric(float64(test.Nanoseconds())/float64(b.N*numBoxes), "ns/box")
+	b.ReportMetric(float64(stats.Visible)/float64(numBoxes), "visible/box")
+}
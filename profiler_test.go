@@ -0,0 +1,71 @@
+package bgfx
+
+import (
+	"encoding/json"
+	"os"
+	"path/filepath"
+	"runtime"
+	"testing"
+)
+
+func TestSaveProfile(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	SetDebug(DebugProfiler)
+	for f := 0; f < 4; f++ {
+		SetViewRect(0, 0, 0, 320, 240)
+		Submit(0)
+		Frame()
+	}
+	SetDebug(0)
+
+	path := filepath.Join(t.TempDir(), "profile.json")
+	if err := SaveProfile(path); err != nil {
+		t.Fatal(err)
+	}
+
+	data, err := os.ReadFile(path)
+	if err != nil {
+		t.Fatal(err)
+	}
+	var trace struct {
+		TraceEvents []struct {
+			Name string
+			Ph   string
+			Tid  int
+			Ts   float64
+			Dur  float64
+			Args map[string]string
+		}
+	}
+	if err := json.Unmarshal(data, &trace); err != nil {
+		t.Fatalf("invalid trace: %v", err)
+	}
+
+	zones := make(map[string]int)
+	threads := make(map[string]bool)
+	for _, ev := range trace.TraceEvents {
+		switch ev.Ph {
+		case "M":
+			threads[ev.Args["name"]] = true
+		case "X":
+			if ev.Ts < 0 || ev.Dur < 0 {
+				t.Errorf("zone %s has negative time", ev.Name)
+			}
+			zones[ev.Name]++
+		}
+	}
+	if !threads["API"] {
+		t.Error("API thread is missing")
+	}
+	for _, name := range []string{"frame", "swap", "execCommands"} {
+		if zones[name] == 0 {
+			t.Errorf("zone %s is missing", name)
+		}
+	}
+}
@@ -0,0 +1,136 @@
+package bgfx
+
+import (
+	"path/filepath"
+	"runtime"
+	"testing"
+)
+
+func TestRecordReplay(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+	Reset(320, 240, 0)
+
+	path := filepath.Join(t.TempDir(), "trace.bin")
+	if err := RecordBegin(path); err != nil {
+		t.Fatal(err)
+	}
+
+	decl := floatDecl()
+	vb := CreateVertexBuffer(make([]floatVertex, 3), decl)
+	ib := CreateIndexBuffer([]uint16{0, 1, 2})
+
+	const numFrames = 4
+	for f := 0; f < numFrames; f++ {
+		SetViewRect(0, 0, 0, 320, 240)
+		SetViewAttachmentHints(0, AttachmentDepth|AttachmentStencil, AttachmentDepth|AttachmentStencil)
+		DebugTextPrintf(0, 1, 0x4f, "frame %d", f)
+		for i := 0; i < 10; i++ {
+			SetTransform([16]float32{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, float32(i), 0, 0, 1})
+			SetVertexBuffer(vb)
+			SetIndexBuffer(ib)
+			Submit(0)
+		}
+		var verts []floatVertex
+		var idxs []uint16
+		tvb, tib, ok := AllocTransientBuffers(&verts, &idxs, decl, 3, 3)
+		if !ok {
+			t.Fatal("transient buffers are full")
+		}
+		copy(idxs, []uint16{0, 1, 2})
+		SetTransientVertexBuffer(tvb, 0, 3)
+		SetTransientIndexBuffer(tib, 0, 3)
+		Submit(1)
+		Frame()
+	}
+
+	RecordEnd()
+	DestroyIndexBuffer(ib)
+	DestroyVertexBuffer(vb)
+	Frame()
+
+	if err := ReplayBegin(path); err != nil {
+		t.Fatal(err)
+	}
+	defer ReplayEnd()
+
+	var frames int
+	for {
+		stats, ok := ReplayFrame()
+		if !ok {
+			break
+		}
+		if stats.Frame != frames {
+			t.Errorf("frame %d: replayed as frame %d", frames, stats.Frame)
+		}
+		if stats.NumSubmits != 11 {
+			t.Errorf("frame %d: %d submits, expected 11", frames, stats.NumSubmits)
+		}
+		t.Logf("frame %d: %d calls, issue %v, frame %v", stats.Frame, stats.NumCalls, stats.IssueTime, stats.FrameTime)
+		frames++
+	}
+
+	if frames != numFrames {
+		t.Errorf("replayed %d frames, expected %d", frames, numFrames)
+	}
+
+	if err := ReplayBegin(filepath.Join(t.TempDir(), "missing.bin")); err == nil {
+		t.Error("replaying missing trace should fail")
+	}
+}
+
+// TestRecordTrailingFrame records calls after last Frame, and shuts down
+// while recording.
+func TestRecordTrailingFrame(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	path := filepath.Join(t.TempDir(), "trace.bin")
+	for pass := 0; pass < 2; pass++ {
+		InitRenderer(RendererTypeNull)
+		Reset(320, 240, 0)
+		// Shutdown must close trace of previous pass.
+		if err := RecordBegin(path); err != nil {
+			t.Fatalf("pass %d: %v", pass, err)
+		}
+
+		decl := floatDecl()
+		Frame()
+		var verts []floatVertex
+		var idxs []uint16
+		tvb, tib, ok := AllocTransientBuffers(&verts, &idxs, decl, 3, 3)
+		if !ok {
+			t.Fatal("transient buffers are full")
+		}
+		copy(idxs, []uint16{0, 1, 2})
+		SetTransientVertexBuffer(tvb, 0, 3)
+		SetTransientIndexBuffer(tib, 0, 3)
+		Submit(0)
+		if pass == 0 {
+			Shutdown()
+			continue
+		}
+		RecordEnd()
+
+		if err := ReplayBegin(path); err != nil {
+			t.Fatal(err)
+		}
+		var submits []int
+		for {
+			stats, ok := ReplayFrame()
+			if !ok {
+				break
+			}
+			submits = append(submits, stats.NumSubmits)
+		}
+		ReplayEnd()
+		Shutdown()
+
+		if len(submits) != 2 || submits[1] != 1 {
+			t.Errorf("replayed submits per frame %v, expected [0 1]", submits)
+		}
+	}
+}
@@ -0,0 +1,142 @@
+package bgfx
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"runtime"
+	"testing"
+	"time"
+)
+
+// testShader builds vertex shader binary with uniform table only, which
+// is all NULL renderer needs. Every variant references predefined
+// uniforms and a few of numNames material uniforms.
+func testShader(variant, numNames int) []byte {
+	var buf bytes.Buffer
+	w := func(v interface{}) { binary.Write(&buf, binary.LittleEndian, v) }
+	uniform := func(name string, typ UniformType, num uint8) {
+		w(uint8(len(name)))
+		buf.WriteString(name)
+		w(uint8(typ))
+		w(num)
+		w(uint16(0))
+		w(uint16(num))
+	}
+
+	buf.WriteString("VSH\x03")
+	w(uint32(variant))
+	names := []string{"u_modelViewProj", "u_model", "u_viewRect"}
+	w(uint16(len(names) + 8))
+	for _, name := range names {
+		uniform(name, Uniform4x4fv, 1)
+	}
+	for i := 0; i < 8; i++ {
+		uniform(fmt.Sprintf("u_material%d", (variant*3+i)%numNames), Uniform4fv, 1)
+	}
+	w(uint16(4))
+	w(uint32(0))
+	return buf.Bytes()
+}
+
+func BenchmarkCreateShader(b *testing.B) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+
+	const numVariants = 256
+	variants := make([][]byte, numVariants)
+	for i := range variants {
+		variants[i] = testShader(i, 64)
+	}
+	shaders := make([]Shader, numVariants)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	start := time.Now()
+	for i := 0; i < b.N; i++ {
+		for j, data := range variants {
+			shaders[j] = CreateShader(data)
+		}
+		for _, sh := range shaders {
+			DestroyShader(sh)
+		}
+		Frame()
+	}
+	b.ReportMetric(float64(time.Since(start).Nanoseconds())/float64(b.N*numVariants), "ns/shader")
+}
+
+func TestPredefinedUniform(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+
+	predefined := []string{
+		"u_viewRect", "u_viewTexel", "u_view", "u_invView",
+		"u_proj", "u_invProj", "u_viewProj", "u_invViewProj",
+		"u_model", "u_modelView", "u_modelViewProj", "u_alphaRef",
+	}
+	for _, name := range predefined {
+		if u := CreateUniform(name, Uniform4x4fv, 1); u.h.idx != invalidHandle {
+			t.Errorf("%s: predefined name returned valid handle %d", name, u.h.idx)
+		}
+	}
+
+	// Prefixes and extensions of predefined names are user uniforms.
+	for _, name := range []string{"u_vie", "u_viewProjX", "u_model0", "u_alpha", "u_alphaRef_"} {
+		u := CreateUniform(name, Uniform4fv, 1)
+		if u.h.idx == invalidHandle {
+			t.Errorf("%s: user uniform returned invalid handle", name)
+			continue
+		}
+		DestroyUniform(u)
+	}
+	Frame()
+}
+
+func TestUniformRecreate(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	InitRenderer(RendererTypeNull)
+	defer Shutdown()
+
+	a := CreateUniform("u_color", Uniform4fv, 1)
+	b := CreateUniform("u_color", Uniform4fv, 1)
+	if a.h.idx == invalidHandle || a != b {
+		t.Fatalf("same name returned handles %d and %d", a.h.idx, b.h.idx)
+	}
+	DestroyUniform(a)
+	SetUniformVec4(b, [4]float32{1, 0, 0, 1})
+	DestroyUniform(b)
+	Frame()
+
+	// Freed handle can be reused by other name, name of destroyed uniform
+	// must not map to it anymore.
+	other := CreateUniform("u_other", Uniform4fv, 1)
+	c := CreateUniform("u_color", Uniform4fv, 1)
+	if c.h.idx == invalidHandle || c == other {
+		t.Fatalf("recreated uniform returned handle %d, other %d", c.h.idx, other.h.idx)
+	}
+	SetUniformVec4(c, [4]float32{0, 1, 0, 1})
+	Frame()
+	DestroyUniform(c)
+	DestroyUniform(other)
+
+	// Uniforms created by shader are released with it.
+	for i := 0; i < 2; i++ {
+		sh := CreateShader(testShader(i, 4))
+		DestroyShader(sh)
+		Frame()
+	}
+	d := CreateUniform("u_material0", Uniform4fv, 1)
+	if d.h.idx == invalidHandle {
+		t.Fatal("uniform released by shader can't be recreated")
+	}
+	DestroyUniform(d)
+	Frame()
+}
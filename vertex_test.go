@@ -0,0 +1,533 @@
+package bgfx
+
+import (
+	"bytes"
+	"math"
+	"reflect"
+	"testing"
+	"unsafe"
+)
+
+type floatVertex struct {
+	Pos    [3]float32
+	Normal [3]float32
+	UV     [2]float32
+	Color  [4]float32
+}
+
+type packedVertex struct {
+	Pos    [4]uint16
+	Normal [4]uint8
+	UV     [2]int16
+	Color  [4]uint8
+}
+
+type posUVVertex struct {
+	Pos [3]float32
+	UV  [2]float32
+}
+
+func floatDecl() VertexDecl {
+	var decl VertexDecl
+	decl.Begin()
+	decl.Add(AttribPosition, 3, AttribTypeFloat, false, false)
+	decl.Add(AttribNormal, 3, AttribTypeFloat, false, false)
+	decl.Add(AttribTexcoord0, 2, AttribTypeFloat, false, false)
+	decl.Add(AttribColor0, 4, AttribTypeFloat, false, false)
+	decl.End()
+	return decl
+}
+
+func packedDecl() VertexDecl {
+	var decl VertexDecl
+	decl.Begin()
+	decl.Add(AttribPosition, 4, AttribTypeHalf, false, false)
+	decl.Add(AttribNormal, 4, AttribTypeUint8, true, true)
+	decl.Add(AttribTexcoord0, 2, AttribTypeInt16, true, true)
+	decl.Add(AttribColor0, 4, AttribTypeUint8, true, false)
+	decl.End()
+	return decl
+}
+
+func posUVDecl() VertexDecl {
+	var decl VertexDecl
+	decl.Begin()
+	decl.Add(AttribPosition, 3, AttribTypeFloat, false, false)
+	decl.Add(AttribTexcoord0, 2, AttribTypeFloat, false, false)
+	decl.End()
+	return decl
+}
+
+// testVertices generates mesh-like vertices, with unit normals and
+// texture coordinates and colors in 0-1 range.
+func testVertices(num int) []floatVertex {
+	verts := make([]floatVertex, num)
+	seed := uint32(1)
+	rnd := func() float32 {
+		seed = seed*1664525 + 1013904223
+		return float32(seed>>8) / float32(1<<24)
+	}
+	for i := range verts {
+		v := &verts[i]
+		for c := range v.Pos {
+			v.Pos[c] = (rnd()*2 - 1) * 100
+		}
+		v.Normal = [3]float32{rnd()*2 - 1, rnd()*2 - 1, rnd()*2 - 1}
+		v.UV = [2]float32{rnd(), rnd()}
+		v.Color = [4]float32{rnd(), rnd(), rnd(), 1}
+	}
+	return verts
+}
+
+func sliceBytes(slice interface{}) []byte {
+	val := reflect.ValueOf(slice)
+	size := val.Len() * int(val.Type().Elem().Size())
+	return (*[1 << 30]byte)(unsafe.Pointer(val.Pointer()))[:size:size]
+}
+
+// vertexConvertRef converts vertices one attribute at a time with
+// VertexUnpack and VertexPack.
+func vertexConvertRef(destDecl, srcDecl VertexDecl, dest, src interface{}, attribs []Attrib) {
+	num := reflect.ValueOf(src).Len()
+	for i := 0; i < num; i++ {
+		for _, attrib := range attribs {
+			v := VertexUnpack(attrib, srcDecl, src, i)
+			VertexPack(v, true, attrib, destDecl, dest, i)
+		}
+	}
+}
+
+func TestVertexConvertPlan(t *testing.T) {
+	attribs := []Attrib{AttribPosition, AttribNormal, AttribTexcoord0, AttribColor0}
+	src := testVertices(1000)
+
+	packed := make([]packedVertex, len(src))
+	want := make([]packedVertex, len(src))
+	NewVertexConvertPlan(packedDecl(), floatDecl()).Convert(packed, src)
+	vertexConvertRef(packedDecl(), floatDecl(), want, src, attribs)
+	if !bytes.Equal(sliceBytes(packed), sliceBytes(want)) {
+		t.Errorf("float to packed doesn't match vertexPack")
+	}
+
+	unpacked := make([]floatVertex, len(src))
+	wantUnpacked := make([]floatVertex, len(src))
+	NewVertexConvertPlan(floatDecl(), packedDecl()).Convert(unpacked, packed)
+	vertexConvertRef(floatDecl(), packedDecl(), wantUnpacked, packed, attribs)
+	if !bytes.Equal(sliceBytes(unpacked), sliceBytes(wantUnpacked)) {
+		t.Errorf("packed to float doesn't match vertexUnpack")
+	}
+
+	posUV := make([]posUVVertex, len(src))
+	NewVertexConvertPlan(posUVDecl(), floatDecl()).Convert(posUV, src)
+	for i := range src {
+		if posUV[i].Pos != src[i].Pos || posUV[i].UV != src[i].UV {
+			t.Errorf("vertex %d: %v, want %v %v", i, posUV[i], src[i].Pos, src[i].UV)
+			break
+		}
+	}
+
+	// attributes missing from source are cleared.
+	back := make([]floatVertex, len(src))
+	NewVertexConvertPlan(floatDecl(), posUVDecl()).Convert(back, posUV)
+	for i := range back {
+		if back[i].Normal != [3]float32{} || back[i].Color != [4]float32{} {
+			t.Errorf("vertex %d: missing attributes not cleared", i)
+			break
+		}
+	}
+}
+
+func BenchmarkVertexConvert(b *testing.B) {
+	const num = 4096
+	src := testVertices(num)
+	packed := make([]packedVertex, num)
+	NewVertexConvertPlan(packedDecl(), floatDecl()).Convert(packed, src)
+
+	b.Run("float-to-packed", func(b *testing.B) {
+		plan := NewVertexConvertPlan(packedDecl(), floatDecl())
+		dest := make([]packedVertex, num)
+		b.SetBytes(int64(len(sliceBytes(src))))
+		for i := 0; i < b.N; i++ {
+			plan.Convert(dest, src)
+		}
+	})
+	b.Run("packed-to-float", func(b *testing.B) {
+		plan := NewVertexConvertPlan(floatDecl(), packedDecl())
+		dest := make([]floatVertex, num)
+		b.SetBytes(int64(len(sliceBytes(packed))))
+		for i := 0; i < b.N; i++ {
+			plan.Convert(dest, packed)
+		}
+	})
+	b.Run("float-to-posuv", func(b *testing.B) {
+		plan := NewVertexConvertPlan(posUVDecl(), floatDecl())
+		dest := make([]posUVVertex, num)
+		b.SetBytes(int64(len(sliceBytes(src))))
+		for i := 0; i < b.N; i++ {
+			plan.Convert(dest, src)
+		}
+	})
+	b.Run("float-to-float", func(b *testing.B) {
+		plan := NewVertexConvertPlan(floatDecl(), floatDecl())
+		dest := make([]floatVertex, num)
+		b.SetBytes(int64(len(sliceBytes(src))))
+		for i := 0; i < b.N; i++ {
+			plan.Convert(dest, src)
+		}
+	})
+	// VertexConvert compiles plan on every call.
+	b.Run("float-to-packed-noplan", func(b *testing.B) {
+		dest := make([]packedVertex, num)
+		b.SetBytes(int64(len(sliceBytes(src))))
+		for i := 0; i < b.N; i++ {
+			VertexConvert(packedDecl(), floatDecl(), dest, src)
+		}
+	})
+}
+
+func TestVertexPackArray(t *testing.T) {
+	src := testVertices(1000)
+	normals := make([][3]float32, len(src))
+	colors := make([][4]float32, len(src))
+	for i := range src {
+		normals[i] = src[i].Normal
+		colors[i] = src[i].Color
+	}
+
+	decl := packedDecl()
+	got := make([]packedVertex, len(src))
+	want := make([]packedVertex, len(src))
+	VertexPackArray(normals, true, AttribNormal, decl, got, 0)
+	VertexPackArray(colors, true, AttribColor0, decl, got, 0)
+	for i := range src {
+		VertexPack([4]float32{normals[i][0], normals[i][1], normals[i][2]}, true, AttribNormal, decl, want, i)
+		VertexPack(colors[i], true, AttribColor0, decl, want, i)
+	}
+	if !bytes.Equal(sliceBytes(got), sliceBytes(want)) {
+		t.Errorf("VertexPackArray doesn't match VertexPack")
+	}
+
+	unpacked := make([][3]float32, len(src)-10)
+	VertexUnpackArray(unpacked, AttribNormal, decl, got, 10)
+	for i := range unpacked {
+		v := VertexUnpack(AttribNormal, decl, got, i+10)
+		if unpacked[i] != [3]float32{v[0], v[1], v[2]} {
+			t.Errorf("vertex %d: unpacked %v, want %v", i+10, unpacked[i], v)
+			break
+		}
+	}
+}
+
+// BenchmarkVertexPack compares filling position of 100k vertices with
+// one call against a call per vertex.
+func BenchmarkVertexPack(b *testing.B) {
+	const num = 100000
+	src := testVertices(num)
+	positions := make([][3]float32, num)
+	for i := range src {
+		positions[i] = src[i].Pos
+	}
+	decl := packedDecl()
+	dest := make([]packedVertex, num)
+
+	b.Run("array", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			VertexPackArray(positions, false, AttribPosition, decl, dest, 0)
+		}
+	})
+	b.Run("vertex", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j, p := range positions {
+				VertexPack([4]float32{p[0], p[1], p[2]}, false, AttribPosition, decl, dest, j)
+			}
+		}
+	})
+}
+
+type posNormalVertex struct {
+	Pos    [3]float32
+	Normal [3]float32
+}
+
+func posNormalDecl() VertexDecl {
+	var decl VertexDecl
+	decl.Begin()
+	decl.Add(AttribPosition, 3, AttribTypeFloat, false, false)
+	decl.Add(AttribNormal, 3, AttribTypeFloat, false, false)
+	decl.End()
+	return decl
+}
+
+// triangleSoup generates unindexed heightfield grid, every inner corner
+// is repeated by 6 triangles with a bit of jitter. Face normals make
+// vertices of neighbour quads differ.
+func triangleSoup(size int, jitter float32) []posNormalVertex {
+	seed := uint32(1)
+	rnd := func() float32 {
+		seed = seed*1664525 + 1013904223
+		return (float32(seed>>8)/float32(1<<24)*2 - 1) * jitter
+	}
+	corner := func(x, y int) [3]float32 {
+		return [3]float32{float32(x)*0.1 + rnd(), float32((x*7+y*3)%5) * 0.02, float32(y)*0.1 + rnd()}
+	}
+	verts := make([]posNormalVertex, 0, size*size*6)
+	for y := 0; y < size; y++ {
+		for x := 0; x < size; x++ {
+			n0 := [3]float32{0, 1, float32((x + y) % 2)}
+			n1 := [3]float32{0, 1, float32((x+y)%2) + 1}
+			verts = append(verts,
+				posNormalVertex{corner(x, y), n0},
+				posNormalVertex{corner(x+1, y), n0},
+				posNormalVertex{corner(x, y+1), n0},
+				posNormalVertex{corner(x+1, y), n1},
+				posNormalVertex{corner(x+1, y+1), n1},
+				posNormalVertex{corner(x, y+1), n1},
+			)
+		}
+	}
+	return verts
+}
+
+func TestWeldVerticesNormals(t *testing.T) {
+	const epsilon = 0.001
+	decl := posNormalDecl()
+	verts := triangleSoup(30, epsilon*0.3)
+
+	got := make([]uint32, len(verts))
+	if num := WeldVertices(got, decl, verts, epsilon); num != 31*31 {
+		t.Fatalf("welded to %d vertices, want %d", num, 31*31)
+	}
+	num := WeldVertices(got, decl, verts, epsilon, AttribNormal)
+	if num <= 31*31 {
+		t.Errorf("welding with normals: %d vertices, want more than %d", num, 31*31)
+	}
+	for i := range got {
+		if verts[i].Normal != verts[got[i]].Normal {
+			t.Errorf("vertex %d welded to %d with different normal", i, got[i])
+			break
+		}
+	}
+}
+
+// shuffledMesh welds triangle soup into indexed mesh, and shuffles its
+// triangles so that the vertex cache is missed almost every time.
+func shuffledMesh(size int) ([]posNormalVertex, []uint32) {
+	decl := posNormalDecl()
+	verts := triangleSoup(size, 0)
+	indices := make([]uint32, len(verts))
+	WeldVertices(indices, decl, verts, 0.001)
+	seed := uint32(7)
+	for i := len(indices)/3 - 1; i > 0; i-- {
+		seed = seed*1664525 + 1013904223
+		j := int(seed>>8) % (i + 1)
+		for k := 0; k < 3; k++ {
+			indices[i*3+k], indices[j*3+k] = indices[j*3+k], indices[i*3+k]
+		}
+	}
+	return verts, indices
+}
+
+func triangleSet(indices []uint32) map[[3]uint32]int {
+	set := make(map[[3]uint32]int)
+	for i := 0; i < len(indices); i += 3 {
+		set[[3]uint32{indices[i], indices[i+1], indices[i+2]}]++
+	}
+	return set
+}
+
+func TestOptimizeMesh(t *testing.T) {
+	const cacheSize = 16
+	decl := posNormalDecl()
+	verts, indices := shuffledMesh(64)
+	tris := triangleSet(indices)
+
+	shuffled := AnalyzeVertexCache(indices, len(verts), cacheSize)
+	if shuffled.ACMR < 2.0 {
+		t.Fatalf("shuffled mesh ACMR %.3f, expected cache to be missed", shuffled.ACMR)
+	}
+
+	OptimizeVertexCache(indices, len(verts))
+	optimized := AnalyzeVertexCache(indices, len(verts), cacheSize)
+	if optimized.ACMR > 0.8 || optimized.ATVR > 1.5 {
+		t.Errorf("optimized ACMR %.3f ATVR %.3f", optimized.ACMR, optimized.ATVR)
+	}
+	if !reflect.DeepEqual(tris, triangleSet(indices)) {
+		t.Fatalf("vertex cache optimization changed triangles")
+	}
+
+	OptimizeOverdraw(indices, decl, verts, cacheSize)
+	overdraw := AnalyzeVertexCache(indices, len(verts), cacheSize)
+	if overdraw.ACMR > optimized.ACMR*1.05 {
+		t.Errorf("overdraw optimized ACMR %.3f, was %.3f", overdraw.ACMR, optimized.ACMR)
+	}
+	if !reflect.DeepEqual(tris, triangleSet(indices)) {
+		t.Fatalf("overdraw optimization changed triangles")
+	}
+
+	original := append([]uint32(nil), indices...)
+	dest := make([]posNormalVertex, len(verts))
+	remap := make([]uint32, len(verts))
+	num := OptimizeVertexFetch(dest, remap, decl, verts, indices)
+	if num != 65*65 {
+		t.Fatalf("vertex fetch optimization kept %d vertices, want %d", num, 65*65)
+	}
+	for i, index := range indices {
+		if remap[original[i]] != index || dest[index] != verts[original[i]] {
+			t.Fatalf("index %d: vertex %d remapped to %d", i, original[i], index)
+		}
+		if i == 0 && index != 0 {
+			t.Fatalf("first vertex remapped to %d", index)
+		}
+	}
+	fetched := AnalyzeVertexCache(indices, num, cacheSize)
+	if fetched != overdraw {
+		t.Errorf("vertex fetch optimization changed cache stats %v, was %v", fetched, overdraw)
+	}
+}
+
+// sphereMesh appends UV sphere with outward facing triangles to verts
+// and indices.
+func sphereMesh(verts []posNormalVertex, indices []uint32, radius float32, rings, segments int) ([]posNormalVertex, []uint32) {
+	base := uint32(len(verts))
+	for r := 0; r <= rings; r++ {
+		theta := math.Pi * float64(r) / float64(rings)
+		for s := 0; s <= segments; s++ {
+			phi := 2 * math.Pi * float64(s) / float64(segments)
+			n := [3]float32{
+				float32(math.Sin(theta) * math.Cos(phi)),
+				float32(math.Cos(theta)),
+				float32(math.Sin(theta) * math.Sin(phi)),
+			}
+			verts = append(verts, posNormalVertex{
+				Pos:    [3]float32{n[0] * radius, n[1] * radius, n[2] * radius},
+				Normal: n,
+			})
+		}
+	}
+	for r := 0; r < rings; r++ {
+		for s := 0; s < segments; s++ {
+			i0 := base + uint32(r*(segments+1)+s)
+			i1 := i0 + uint32(segments+1)
+			indices = append(indices, i0, i0+1, i1, i1, i0+1, i1+1)
+		}
+	}
+	return verts, indices
+}
+
+// measureOverdraw rasterizes mesh with back face culling and depth test
+// from six axis aligned orthographic views, and returns number of depth
+// test passes per covered pixel.
+func measureOverdraw(verts []posNormalVertex, indices []uint32) float32 {
+	const size = 64
+	var passes, covered int
+	depth := make([]float32, size*size)
+	for view := 0; view < 6; view++ {
+		axis, sign := view/2, float32(1-view%2*2)
+		u, v := (axis+1)%3, (axis+2)%3
+		for i := range depth {
+			depth[i] = math.MaxFloat32
+		}
+		for i := 0; i < len(indices); i += 3 {
+			var sx, sy, sz [3]float32
+			for k := 0; k < 3; k++ {
+				p := verts[indices[i+k]].Pos
+				sx[k] = (p[u]*0.45 + 0.5) * size
+				sy[k] = (p[v]*0.45 + 0.5) * size
+				sz[k] = -sign * p[axis]
+			}
+			p0, p1, p2 := verts[indices[i]].Pos, verts[indices[i+1]].Pos, verts[indices[i+2]].Pos
+			e1 := [3]float32{p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]}
+			e2 := [3]float32{p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]}
+			normal := [3]float32{
+				e1[1]*e2[2] - e1[2]*e2[1],
+				e1[2]*e2[0] - e1[0]*e2[2],
+				e1[0]*e2[1] - e1[1]*e2[0],
+			}
+			if normal[axis]*sign <= 0 {
+				continue
+			}
+			area := (sx[1]-sx[0])*(sy[2]-sy[0]) - (sx[2]-sx[0])*(sy[1]-sy[0])
+			if area == 0 {
+				continue
+			}
+			for y := 0; y < size; y++ {
+				for x := 0; x < size; x++ {
+					px, py := float32(x)+0.5, float32(y)+0.5
+					w0 := ((sx[1]-px)*(sy[2]-py) - (sx[2]-px)*(sy[1]-py)) / area
+					w1 := ((sx[2]-px)*(sy[0]-py) - (sx[0]-px)*(sy[2]-py)) / area
+					w2 := 1 - w0 - w1
+					if w0 < 0 || w1 < 0 || w2 < 0 {
+						continue
+					}
+					z := w0*sz[0] + w1*sz[1] + w2*sz[2]
+					if z < depth[y*size+x] {
+						if depth[y*size+x] == math.MaxFloat32 {
+							covered++
+						}
+						depth[y*size+x] = z
+						passes++
+					}
+				}
+			}
+		}
+	}
+	return float32(passes) / float32(covered)
+}
+
+func TestOptimizeOverdraw(t *testing.T) {
+	const cacheSize = 16
+	decl := posNormalDecl()
+	// Inner sphere drawn first is hidden behind outer one, so every
+	// pixel it covers is shaded twice.
+	verts, indices := sphereMesh(nil, nil, 0.5, 16, 32)
+	verts, indices = sphereMesh(verts, indices, 1, 16, 32)
+	tris := triangleSet(indices)
+
+	OptimizeVertexCache(indices, len(verts))
+	before := measureOverdraw(verts, indices)
+	OptimizeOverdraw(indices, decl, verts, cacheSize)
+	after := measureOverdraw(verts, indices)
+	if !reflect.DeepEqual(tris, triangleSet(indices)) {
+		t.Fatalf("overdraw optimization changed triangles")
+	}
+	if after > before*0.9 {
+		t.Errorf("overdraw %.3f, was %.3f", after, before)
+	}
+}
+
+func TestOptimizeIndexRange(t *testing.T) {
+	decl := posNormalDecl()
+	verts, indices := sphereMesh(nil, nil, 1, 4, 4)
+	indices[len(indices)-1] = uint32(len(verts))
+	for name, fn := range map[string]func(){
+		"OptimizeVertexCache": func() { OptimizeVertexCache(indices, len(verts)) },
+		"OptimizeOverdraw":    func() { OptimizeOverdraw(indices, decl, verts, 16) },
+		"AnalyzeVertexCache":  func() { AnalyzeVertexCache(indices, len(verts), 16) },
+		"OptimizeVertexFetch": func() {
+			OptimizeVertexFetch(make([]posNormalVertex, len(verts)), make([]uint32, len(verts)), decl, verts, indices)
+		},
+	} {
+		func() {
+			defer func() {
+				if recover() != errIndexRange {
+					t.Errorf("%s: expected index range panic", name)
+				}
+			}()
+			fn()
+		}()
+	}
+}
+
+func BenchmarkOptimizeVertexCache(b *testing.B) {
+	verts, shuffled := shuffledMesh(256)
+	indices := make([]uint32, len(shuffled))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		copy(indices, shuffled)
+		OptimizeVertexCache(indices, len(verts))
+	}
+	b.StopTimer()
+	stats := AnalyzeVertexCache(indices, len(verts), 16)
+	b.ReportMetric(float64(stats.ACMR), "ACMR")
+	b.ReportMetric(float64(len(indices)/3), "triangles")
+}
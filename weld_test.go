@@ -0,0 +1,60 @@
+//go:build bgfx_test
+// +build bgfx_test
+
+package bgfx
+
+import (
+	"fmt"
+	"testing"
+)
+
+func TestWeldVertices(t *testing.T) {
+	const epsilon = 0.001
+	decl := posNormalDecl()
+	verts := triangleSoup(30, epsilon*0.3)
+
+	want := make([]uint16, len(verts))
+	wantNum := weldVerticesRef(want, decl, verts, epsilon)
+	if wantNum != 31*31 {
+		t.Fatalf("reference welded to %d vertices, want %d", wantNum, 31*31)
+	}
+
+	js := newJobSystem(4)
+	defer js.destroy()
+	for _, threaded := range []bool{false, true} {
+		if threaded {
+			js.attach()
+		}
+		got := make([]uint32, len(verts))
+		if num := WeldVertices(got, decl, verts, epsilon); num != wantNum {
+			t.Errorf("threaded %v: welded to %d vertices, want %d", threaded, num, wantNum)
+		}
+		for i := range got {
+			if got[i] != uint32(want[i]) {
+				t.Errorf("threaded %v: vertex %d welded to %d, want %d", threaded, i, got[i], want[i])
+				break
+			}
+		}
+		detachJobSystem()
+	}
+}
+
+// BenchmarkWeldVertices welds ~2M vertex triangle soup.
+func BenchmarkWeldVertices(b *testing.B) {
+	decl := posNormalDecl()
+	verts := triangleSoup(600, 0.0002)
+	output := make([]uint32, len(verts))
+	for _, threads := range []int{1, 2, 4, 8} {
+		b.Run(fmt.Sprintf("threads=%d", threads), func(b *testing.B) {
+			js := newJobSystem(threads)
+			js.attach()
+			defer js.destroy()
+			defer detachJobSystem()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				WeldVertices(output, decl, verts, 0.001)
+			}
+			b.ReportMetric(float64(len(verts)), "vertices")
+		})
+	}
+}